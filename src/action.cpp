@@ -19,126 +19,116 @@
 #include "utils.hpp"
 
 static constexpr const float TRANSITION_SPEED{ 1.25f };
+static constexpr const size_t TRANSITION_SPAWN_BUDGET{ 4 };
 
 void Game::schedule_action_change_level(const Level &level, size_t mission, const Interactable *obj) noexcept
 {
-  StopMusicStream(current_music);
+  music->stop();
 
   TraceLog(LOG_INFO, "Changing level to %i (mission: %i)", static_cast<int>(level), mission);
 
+  actions.push(script_change_level(level, mission, obj->get_sprite().get_destination_rect()));
+}
+
+Script Game::script_change_level(Level level, size_t mission, Rectangle target_rect)
+{
   // player animation
+  const Vector2 target_position{ target_rect.x, target_rect.y };
+  while (true)
   {
-    Action action;
-    action.on_update = [this, target_rect = obj->get_sprite().get_destination_rect()](Action &action)
-    {
-      bool reached_interactable{ false };
-      const Vector2 target_position{ target_rect.x, target_rect.y };
-      if (PlayerShip *player_ship = dynamic_cast<PlayerShip *>(player.get()); player_ship)
-      {
-        player_ship->position = Vector2Lerp(player_ship->position, target_position, 0.05f);
-
-        if (player_ship->sprite.scale.x > 0.1f)
-          player_ship->sprite.scale = Vector2Scale(player_ship->sprite.scale, 0.9f);
-
-        reached_interactable =
-          Vector2Distance(player_ship->sprite.position, target_position) < 4.0f || player_ship->sprite.scale.x < 0.1f;
-      }
-      if (PlayerCharacter *player_character = dynamic_cast<PlayerCharacter *>(player.get()); player_character)
-      {
-        const Vector2 pos{ player_character->position.x, player_character->position.y + 8.0f };
-        const float walk_speed = 0.5f;
-        if (pos.x < target_position.x)
-          player_character->velocity.x = walk_speed;
-        else if (pos.x > target_position.x)
-          player_character->velocity.x = -walk_speed;
-        else
-          player_character->velocity.x = 0.0f;
-
-        if (pos.y < target_position.y)
-          player_character->velocity.y = walk_speed;
-        else if (pos.y > target_position.y)
-          player_character->velocity.y = -walk_speed;
-        else
-          player_character->velocity.y = 0.0f;
-
-        player_character->position = Vector2Add(player_character->position, player_character->velocity);
-        player_character->animate();
+    const bool reached_interactable = move_player_towards(target_position);
+    freeze_entities                 = true;
+    if (reached_interactable)
+      break;
 
-        if (Vector2Distance(pos, target_position) < 8.0f)
-          reached_interactable = true;
-      }
-
-      freeze_entities = true;
-
-      if (reached_interactable)
-        action.is_done = true;
-    };
-
-    actions.push(std::move(action));
+    co_await Script::next_tick();
   }
+  co_await Script::next_tick(Script::Overlay::Iris, 0.0f);
 
   // fade-out transition
+  switch (level)
   {
-    Action action;
-    action.on_update = [](Action &action)
-    {
-      action.data = std::get<float>(action.data) + DELTA_TIME * TRANSITION_SPEED;
-
-      if (std::get<float>(action.data) >= 1.0f)
-        action.is_done = true;
-    };
+    case Level::None:
+      assert(false);
+      break;
+    case Level::Asteroids:
+      prepare_state(GameState::PLAYING_ASTEROIDS, mission);
+      break;
+    case Level::Station:
+      prepare_state(GameState::PLAYING_STATION, current_mission);
+      break;
+  }
 
-    action.on_draw = [](const Action &action)
-    {
-      const float &data = std::get<float>(action.data);
-      const float size  = std::max(width, height) * 0.5f * data;
-      DrawPoly(Vector2{ width * 0.5f, height * 0.5f }, 16, size, data * 0.1f, BLACK);
-    };
+  for (float progress = 0.0f;;)
+  {
+    prepare_state_step(TRANSITION_SPAWN_BUDGET);
 
-    action.on_done = [this, level, mission](Action &)
-    {
-      switch (level)
-      {
-        case Level::None:
-          assert(false);
-          break;
-        case Level::Asteroids:
-          set_mission(mission);
-          set_state(GameState::PLAYING_ASTEROIDS);
-          break;
-        case Level::Station:
-          set_state(GameState::PLAYING_STATION);
-          set_room(Room::Type::DockingBay);
-          break;
-      }
-    };
+    progress += DELTA_TIME * TRANSITION_SPEED;
+    if (progress >= 1.0f)
+      break;
 
-    action.data = 0.0f;
-    actions.push(std::move(action));
+    co_await Script::next_tick(Script::Overlay::Iris, progress);
   }
 
+  swap_prepared_state();
+
+  if (level == Level::Station)
+    set_room(Room::Type::DockingBay);
+
+  co_await Script::next_tick(Script::Overlay::Ring, 0.0f);
+
   // fade-in transition
+  for (float progress = 0.0f;;)
   {
-    Action action;
-    action.on_update = [](Action &action)
-    {
-      action.data = std::get<float>(action.data) + DELTA_TIME * TRANSITION_SPEED;
+    progress += DELTA_TIME * TRANSITION_SPEED;
+    if (progress >= 1.0f)
+      break;
 
-      if (std::get<float>(action.data) >= 1.0f)
-        action.is_done = true;
-    };
+    co_await Script::next_tick(Script::Overlay::Ring, progress);
+  }
 
-    action.on_draw = [](const Action &action)
-    {
-      const float &data = std::get<float>(action.data);
-      DrawRing(Vector2{ width * 0.5f, height * 0.5f }, width * data, width, 0.0f, 360.0f, 16, BLACK);
-    };
+  freeze_entities = false;
+}
 
-    action.on_done = [this](Action &) { freeze_entities = false; };
+bool Game::move_player_towards(const Vector2 &target_position) noexcept
+{
+  bool reached_interactable{ false };
+  if (PlayerShip *player_ship = dynamic_cast<PlayerShip *>(player.get()); player_ship)
+  {
+    player_ship->position = Vector2Lerp(player_ship->position, target_position, 0.05f);
+
+    if (player_ship->sprite.scale.x > 0.1f)
+      player_ship->sprite.scale = Vector2Scale(player_ship->sprite.scale, 0.9f);
 
-    action.data = 0.0f;
-    actions.push(std::move(action));
+    reached_interactable =
+      Vector2Distance(player_ship->sprite.position, target_position) < 4.0f || player_ship->sprite.scale.x < 0.1f;
   }
+  if (PlayerCharacter *player_character = dynamic_cast<PlayerCharacter *>(player.get()); player_character)
+  {
+    const Vector2 pos{ player_character->position.x, player_character->position.y + 8.0f };
+    const float walk_speed = 0.5f;
+    if (pos.x < target_position.x)
+      player_character->velocity.x = walk_speed;
+    else if (pos.x > target_position.x)
+      player_character->velocity.x = -walk_speed;
+    else
+      player_character->velocity.x = 0.0f;
+
+    if (pos.y < target_position.y)
+      player_character->velocity.y = walk_speed;
+    else if (pos.y > target_position.y)
+      player_character->velocity.y = -walk_speed;
+    else
+      player_character->velocity.y = 0.0f;
+
+    player_character->position = Vector2Add(player_character->position, player_character->velocity);
+    player_character->animate();
+
+    if (Vector2Distance(pos, target_position) < 8.0f)
+      reached_interactable = true;
+  }
+
+  return reached_interactable;
 }
 
 void Game::schedule_action_conversation(DialogEntity &entity) noexcept
@@ -240,7 +230,7 @@ void Game::schedule_action_shop(const Interactable *interactable) noexcept
                                     .on_accept =
                                       [this]
                                     {
-                                      crystals -= 10;
+                                      spend_crystals(10);
                                       guns[GunType::Fast] = true;
                                     },
                                     .on_has_item     = [this](const ShopItem &) { return guns[GunType::Fast]; },
@@ -251,7 +241,7 @@ void Game::schedule_action_shop(const Interactable *interactable) noexcept
                                     .on_accept =
                                       [this]
                                     {
-                                      crystals -= 40;
+                                      spend_crystals(40);
                                       guns[GunType::Assisted] = true;
                                     },
                                     .on_has_item     = [this](const ShopItem &) { return guns[GunType::Assisted]; },
@@ -262,7 +252,7 @@ void Game::schedule_action_shop(const Interactable *interactable) noexcept
                                     .on_accept =
                                       [this]
                                     {
-                                      crystals -= 90;
+                                      spend_crystals(90);
                                       guns[GunType::Homing] = true;
                                     },
                                     .on_has_item     = [this](const ShopItem &) { return guns[GunType::Homing]; },
@@ -564,78 +554,62 @@ void Game::schedule_action_change_room(const Room::Type &room_type) noexcept
 
   freeze_entities = true;
 
+  actions.push(script_change_room(room_type, room));
+}
+
+Script Game::script_change_room(Room::Type room_type, std::shared_ptr<Room> old_room)
+{
   // fade to black
+  for (float progress = 0.0f;;)
   {
-    Action action;
-    action.on_update = [](Action &action)
-    {
-      action.data = std::get<float>(action.data) + DELTA_TIME * TRANSITION_SPEED * 3.0f;
+    progress += DELTA_TIME * TRANSITION_SPEED * 3.0f;
+    if (progress >= 1.0f)
+      break;
 
-      if (std::get<float>(action.data) >= 1.0f)
-        action.is_done = true;
-    };
-    action.on_draw = [](const Action &action)
-    {
-      const float &data         = std::get<float>(action.data);
-      const unsigned char alpha = 255.0f * data;
-      DrawRectangle(0, 0, width, height, Color{ 0, 0, 0, alpha });
-    };
-    action.data = 0.0f;
-    actions.push(std::move(action));
+    co_await Script::next_tick(Script::Overlay::Black, progress);
   }
+  co_await Script::next_tick(Script::Overlay::Black, 1.0f);
 
   // change level
   {
-    Action action;
-    action.on_update = [this, room_type, old_room = room](Action &action)
-    {
-      auto new_room = Room::get(room_type);
+    auto new_room = Room::get(room_type);
 
-      // NOTE: Player's position is relative to the room position,
-      //       so we need to convert it to world coordinates
-      //       and then back to the new room's coordinates
-      player->position = position_to_room(position_to_world(player->position, old_room->rect), new_room->rect);
+    // NOTE: Player's position is relative to the room position,
+    //       so we need to convert it to world coordinates
+    //       and then back to the new room's coordinates
+    player->position = position_to_room(position_to_world(player->position, old_room->rect), new_room->rect);
 
-      set_room(room_type);
-
-      action.is_done = true;
-    };
-    action.on_draw = [](const Action &) { DrawRectangle(0, 0, width, height, Color{ 0, 0, 0, 255 }); };
-    actions.push(std::move(action));
+    set_room(room_type);
   }
+  co_await Script::next_tick(Script::Overlay::Black, 1.0f);
 
   // fade from black
+  for (float progress = 0.0f;;)
   {
-    Action action;
-    action.on_update = [](Action &action)
-    {
-      action.data = std::get<float>(action.data) + DELTA_TIME * TRANSITION_SPEED * 2.0f;
+    progress += DELTA_TIME * TRANSITION_SPEED * 2.0f;
+    if (progress >= 1.0f)
+      break;
 
-      if (std::get<float>(action.data) >= 1.0f)
-        action.is_done = true;
-    };
-    action.on_draw = [](const Action &action)
-    {
-      const float &data         = std::get<float>(action.data);
-      const unsigned char alpha = 255.0f * (1.0f - data);
-      DrawRectangle(0, 0, width, height, Color{ 0, 0, 0, alpha });
-    };
-    action.on_done = [this](Action &) { freeze_entities = false; };
-    action.data    = 0.0f;
-    actions.push(std::move(action));
+    co_await Script::next_tick(Script::Overlay::Black, 1.0f - progress);
   }
+
+  freeze_entities = false;
 }
 
 void Game::set_room(const Room::Type &room_type) noexcept
 {
-  if (!IsMusicStreamPlaying(current_music) && room_type == Room::Type::MainHall)
+  if (!music->is_playing() && room_type == Room::Type::MainHall && !station_music.empty())
   {
-    current_music = station_music[GetRandomValue(0, station_music.size() - 1)];
-    PlayMusicStream(current_music);
-    SetMusicVolume(current_music, music_volume);
+    music->play(station_music.take());
+    if (!asteroid_music.empty())
+      music->prefetch(asteroid_music.peek());
   }
 
   room = Room::get(room_type);
+  world_revision++;
+
+  for (auto &interactable : room->interactables)
+    interactable->schedule_events(*events);
 
   if (!room->tileset_name.empty() && (!tileset_sprite || tileset_sprite->get_path() != room->tileset_name))
     tileset_sprite = std::make_unique<Sprite>(room->tileset_name);
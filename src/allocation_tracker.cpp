@@ -0,0 +1,204 @@
+#include "allocation_tracker.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(TRACK_ALLOCATIONS)
+namespace
+{
+// NOTE: Trivial, so it is usable from the first allocation of a thread and has nothing to destroy at its exit
+thread_local AllocationCounters counters;
+
+void *allocate(std::size_t size) noexcept
+{
+  void *ptr = std::malloc(size > 0 ? size : 1);
+  if (ptr)
+  {
+    counters.allocations++;
+    counters.bytes += size;
+  }
+  return ptr;
+}
+
+void *allocate_aligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  // NOTE: aligned_alloc takes a size that is a multiple of the alignment
+  const std::size_t aligned_size = (size + align - 1) / align * align;
+#if defined(_WIN32)
+  void *ptr = _aligned_malloc(aligned_size > 0 ? aligned_size : align, align);
+#else
+  void *ptr = std::aligned_alloc(align, aligned_size > 0 ? aligned_size : align);
+#endif
+  if (ptr)
+  {
+    counters.allocations++;
+    counters.bytes += size;
+  }
+  return ptr;
+}
+
+void deallocate(void *ptr) noexcept
+{
+  if (!ptr)
+    return;
+
+  counters.frees++;
+  std::free(ptr);
+}
+
+void deallocate_aligned(void *ptr) noexcept
+{
+  if (!ptr)
+    return;
+
+  counters.frees++;
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+void *allocate_or_throw(std::size_t size)
+{
+  void *ptr = allocate(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void *allocate_aligned_or_throw(std::size_t size, std::align_val_t alignment)
+{
+  void *ptr = allocate_aligned(size, alignment);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+  return allocate_or_throw(size);
+}
+
+void *operator new[](std::size_t size)
+{
+  return allocate_or_throw(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate_aligned_or_throw(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return allocate_aligned_or_throw(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+  return allocate_aligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+  return allocate_aligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+  deallocate_aligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+  deallocate_aligned(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{
+  deallocate_aligned(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept
+{
+  deallocate_aligned(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  deallocate_aligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  deallocate_aligned(ptr);
+}
+#endif
+
+AllocationCounters &AllocationCounters::operator+=(const AllocationCounters &other) noexcept
+{
+  allocations += other.allocations;
+  bytes += other.bytes;
+  frees += other.frees;
+  return *this;
+}
+
+AllocationCounters AllocationCounters::operator-(const AllocationCounters &other) const noexcept
+{
+  return AllocationCounters{ .allocations = allocations - other.allocations,
+                             .bytes       = bytes - other.bytes,
+                             .frees       = frees - other.frees };
+}
+
+AllocationCounters AllocationCounters::read() noexcept
+{
+#if defined(TRACK_ALLOCATIONS)
+  return counters;
+#else
+  return AllocationCounters{};
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// NOTE: Heap allocations of the calling thread. They are only counted in builds with TRACK_ALLOCATIONS,
+//       which replaces the global operator new and delete, otherwise read() stays at zero.
+#if defined(TRACK_ALLOCATIONS)
+inline constexpr bool ALLOCATION_TRACKING{ true };
+#else
+inline constexpr bool ALLOCATION_TRACKING{ false };
+#endif
+
+struct AllocationCounters
+{
+  uint64_t allocations{ 0 };
+  uint64_t bytes{ 0 };
+  uint64_t frees{ 0 };
+
+  AllocationCounters &operator+=(const AllocationCounters &other) noexcept;
+  [[nodiscard]] AllocationCounters operator-(const AllocationCounters &other) const noexcept;
+
+  // counters of the calling thread since it started
+  [[nodiscard]] static AllocationCounters read() noexcept;
+};
@@ -3,35 +3,45 @@
 #include <cassert>
 
 #include "bullet.hpp"
+#include "emitter.hpp"
 #include "game.hpp"
 #include "particle.hpp"
 #include "pickable.hpp"
 #include "player.hpp"
 #include "player_ship.hpp"
+#include "timing_wheel.hpp"
 #include "utils.hpp"
 
 #include "magic_enum/magic_enum.hpp"
 
 static constexpr const float ASTEROIDS_SIZE[]{ 8.0f, 16.0f, 32.0f };
 static constexpr const int ASTEROID_SPLIT_COUNT{ 2 };
+static constexpr const uint32_t ALIEN_FIRE_PERIOD{ 240 };
+static constexpr const int ALIEN_BULLET_MIN_LIFETIME{ 180 };
+static constexpr const int ALIEN_BULLET_MAX_LIFETIME{ 240 };
+
+// Collision shapes indexed by Asteroid::Type
+static constexpr const Circle TYPE_SHAPES[]{
+  Circle{ Vector2{ 0.0f, 0.0f }, ASTEROIDS_SIZE[0] * 0.5f },
+  Circle{ Vector2{ 0.0f, 0.0f }, ASTEROIDS_SIZE[1] * 0.5f },
+  Circle{ Vector2{ 0.0f, 0.0f }, ASTEROIDS_SIZE[2] * 0.5f },
+  Circle{ Vector2{ 0.0f, 0.0f }, ASTEROIDS_SIZE[2] * 0.5f },
+  Circle{ Vector2{ 0.0f, 0.0f }, 16.0f },
+  Circle{ Vector2{ 0.0f, 0.0f }, 4.0f },
+};
+static constexpr const Circle BULLET_SHAPE{ Vector2{ 0.0f, 0.0f }, 5.0f };
 
-std::unique_ptr<Sprite> Asteroid::ASTEROID_SPRITE{ nullptr };
-std::unique_ptr<Sprite> Asteroid::ALIEN_SHIP_SPRITE{ nullptr };
-
-Particle create_asteroid_particle(const Vector2 &position, unsigned char alpha = 255)
+[[nodiscard]] static uint32_t next_asteroid_id() noexcept
 {
-  const Vector2 pos{ position.x + static_cast<float>(GetRandomValue(-10, 10)),
-                     position.y + static_cast<float>(GetRandomValue(-10, 10)) };
-  const Vector2 vel = Vector2Normalize(
-    Vector2{ static_cast<float>(GetRandomValue(-100, 100)), static_cast<float>(GetRandomValue(-100, 100)) });
-  const float hue        = 229.0f - 10.0f + static_cast<float>(GetRandomValue(0, 20));
-  const float saturation = 0.3f + static_cast<float>(GetRandomValue(0, 10)) / 100.0f;
-  const float value      = 0.1f + static_cast<float>(GetRandomValue(0, 50)) / 100.0f;
-  Color color            = ColorFromHSV(hue, saturation, value);
-  color.a                = alpha;
-  return Particle::create(pos, vel, color);
+  static uint32_t last_id{ 0 };
+  if (++last_id == 0)
+    ++last_id;
+  return last_id;
 }
 
+std::unique_ptr<Sprite> Asteroid::ASTEROID_SPRITE{ nullptr };
+std::unique_ptr<Sprite> Asteroid::ALIEN_SHIP_SPRITE{ nullptr };
+
 static std::unordered_map<uint8_t, Asteroid::Type> size_type_map{
   { 0, Asteroid::Type::Size1 },
   { 1, Asteroid::Type::Size2 },
@@ -54,12 +64,11 @@ static std::unordered_map<Asteroid::Type, std::string> type_tag_map{ { Asteroid:
   const float speed_factor = 0.5f + (4.0f - static_cast<float>(size)) * 0.3f * 0.5f;
   const float random_angle = (static_cast<float>(GetRandomValue(0, 100)) / 100.0f) * M_PI * 2.0f;
   Asteroid asteroid;
-  asteroid.position     = position;
-  asteroid.velocity.x   = cos(random_angle) * speed_factor;
-  asteroid.velocity.y   = sin(random_angle) * speed_factor;
-  asteroid.type         = size_type_map[size];
-  const float mask_size = ASTEROIDS_SIZE[size] * 0.5f;
-  asteroid.mask.shapes.push_back(Circle{ Vector2{ 0.0f, 0.0f }, mask_size });
+  asteroid.id         = next_asteroid_id();
+  asteroid.position   = position;
+  asteroid.velocity.x = cos(random_angle) * speed_factor;
+  asteroid.velocity.y = sin(random_angle) * speed_factor;
+  asteroid.type       = size_type_map[size];
   return asteroid;
 }
 
@@ -71,12 +80,11 @@ static std::unordered_map<Asteroid::Type, std::string> type_tag_map{ { Asteroid:
   const float speed_factor = 0.5f + (4.0f - static_cast<float>(2)) * 0.3f * 0.3f;
   const float random_angle = (static_cast<float>(GetRandomValue(0, 100)) / 100.0f) * M_PI * 2.0f;
   Asteroid asteroid;
-  asteroid.position     = position;
-  asteroid.velocity.x   = cos(random_angle) * speed_factor;
-  asteroid.velocity.y   = sin(random_angle) * speed_factor;
-  asteroid.type         = Asteroid::Type::Crystal;
-  const float mask_size = ASTEROIDS_SIZE[2] * 0.5f;
-  asteroid.mask.shapes.push_back(Circle{ Vector2{ 0.0f, 0.0f }, mask_size });
+  asteroid.id         = next_asteroid_id();
+  asteroid.position   = position;
+  asteroid.velocity.x = cos(random_angle) * speed_factor;
+  asteroid.velocity.y = sin(random_angle) * speed_factor;
+  asteroid.type       = Asteroid::Type::Crystal;
   return asteroid;
 }
 
@@ -86,11 +94,11 @@ static std::unordered_map<Asteroid::Type, std::string> type_tag_map{ { Asteroid:
     ALIEN_SHIP_SPRITE = std::make_unique<Sprite>("resources/alien_ship.aseprite");
 
   Asteroid asteroid;
+  asteroid.id         = next_asteroid_id();
   asteroid.position   = position;
   asteroid.velocity.x = 1.0f;
   asteroid.velocity.y = 0.0f;
   asteroid.type       = Asteroid::Type::AlienShip;
-  asteroid.mask.shapes.push_back(Circle{ Vector2{ 0.0f, 0.0f }, 16.0f });
   return asteroid;
 }
 
@@ -100,20 +108,25 @@ static std::unordered_map<Asteroid::Type, std::string> type_tag_map{ { Asteroid:
     ALIEN_SHIP_SPRITE = std::make_unique<Sprite>("resources/alien_ship.aseprite");
 
   Asteroid asteroid;
+  asteroid.id         = next_asteroid_id();
   asteroid.position   = position;
   asteroid.velocity.x = direction.x * 2.0f;
   asteroid.velocity.y = direction.y * 2.0f;
   asteroid.type       = Asteroid::Type::AlienBullet;
-  asteroid.mask.shapes.push_back(Circle{ Vector2{ 0.0f, 0.0f }, 4.0f });
   return asteroid;
 }
 
-bool Asteroid::update()
+void Asteroid::move() noexcept
 {
   position.x += velocity.x;
   position.y += velocity.y;
 
   wrap_position(position);
+}
+
+void Asteroid::check_bullets()
+{
+  const float radius = get_shape().radius;
 
   GAME.bullets->for_each(
     [&](Bullet &bullet) -> bool
@@ -121,14 +134,11 @@ bool Asteroid::update()
       if (bullet.life <= 0)
         return true;
 
-      const Mask bullet_mask{ bullet.position, { Circle{ Vector2{ 0.0f, 0.0f }, 5.0f } } };
-
-      if (mask.check_collision(bullet_mask))
+      if (CheckCollisionCircles(position, radius, bullet.position, BULLET_SHAPE.radius))
       {
         life--;
 
-        for (int i = 0; i < 20; i++)
-          GAME.particles->push(create_asteroid_particle(position, 100));
+        ParticleEmitter::emit(Emitter::AsteroidDust, position, 20);
 
         bullet.life = 0;
         return false;
@@ -136,67 +146,70 @@ bool Asteroid::update()
 
       return true;
     });
+}
 
-  mask.position = position;
+bool Asteroid::update_rock()
+{
+  move();
+  check_bullets();
 
   if (life <= 0)
   {
-    die();
+    die_rock();
     return false;
   }
 
-  if (type == Type::AlienShip)
-  {
-    if (GAME.player)
-    {
-      if (GAME.frame % 240 == 0)
-      {
-        if (GetRandomValue(0, 1) == 0)
-        {
-          const Vector2 direction = Vector2Normalize(Vector2Subtract(GAME.player->position, position));
-          GAME.asteroids->push(Asteroid::create_alien_bullet(position, direction));
-        }
-      }
-    }
-    velocity.y = sin(static_cast<float>(GAME.frame) / 100.0f) * 0.5f;
-  }
-  if (type == Type::AlienBullet)
+  return true;
+}
+
+bool Asteroid::update_crystal()
+{
+  move();
+  check_bullets();
+
+  if (life <= 0)
   {
-    if (GAME.frame % 10 == 0)
-    {
-      for (int i = 0; i < 10; i++)
-        GAME.particles->push(Particle::create(position, Vector2Scale(velocity, 0.5f), ColorAlpha(RED, 0.9f)));
-    }
-    const int r = GetRandomValue(0, 60);
-    if (GAME.frame % (180 + r) == 0)
-    {
-      life--;
-    }
+    die_crystal();
+    return false;
   }
 
   return true;
 }
 
-void Asteroid::die()
+bool Asteroid::update_alien_ship()
 {
-  if (type == Type::AlienShip)
+  move();
+  check_bullets();
+
+  if (life <= 0)
   {
-    GAME.score += 1000;
-    for (int i = 0; i < 100; i++)
-      GAME.particles->push(Particle::create(
-        position,
-        Vector2{ static_cast<float>(GetRandomValue(-1, 1)), static_cast<float>(GetRandomValue(-1, 1)) },
-        Color{ 200, 255, 55, 250 }));
+    die_alien_ship();
+    return false;
   }
 
-  if (type == Type::AlienBullet)
-    return;
+  velocity.y = sin(static_cast<float>(GAME.frame) / 100.0f) * 0.5f;
 
-  static SMSound sound1 = SoundManager::get("resources/explosion_asteroid1.wav");
-  static SMSound sound2 = SoundManager::get("resources/explosion_asteroid2.wav");
-  static SMSound sound3 = SoundManager::get("resources/explosion_asteroid3.wav");
+  return true;
+}
 
-  const uint8_t type_int = static_cast<uint8_t>(type);
+bool Asteroid::update_alien_bullet()
+{
+  move();
+  check_bullets();
+
+  if (life <= 0)
+    return false;
+
+  if (GAME.frame % 10 == 0)
+    ParticleEmitter::emit(Emitter::AlienBulletTrail, position, 10, velocity);
+  return true;
+}
+
+static void play_explosion_sound(uint8_t type_int)
+{
+  static SMSound sound1 = SoundManager::get("resources/explosion_asteroid1.qoa");
+  static SMSound sound2 = SoundManager::get("resources/explosion_asteroid2.qoa");
+  static SMSound sound3 = SoundManager::get("resources/explosion_asteroid3.qoa");
 
   if (type_int <= 0)
     sound1.play();
@@ -204,12 +217,21 @@ void Asteroid::die()
     sound2.play();
   else
     sound3.play();
+}
+
+void Asteroid::die_rock()
+{
+  GAME.event_bus.publish(GameEvent{ .type = GameEvent::Type::AsteroidDestroyed, .value = static_cast<size_t>(type) });
+
+  const uint8_t type_int = static_cast<uint8_t>(type);
+
+  play_explosion_sound(type_int);
 
   if (type == Type::Size2 || type == Type::Size3)
   {
     for (size_t i = 0; i < ASTEROID_SPLIT_COUNT; i++)
     {
-      GAME.asteroids->push(Asteroid::create_normal(position, type_int - 1));
+      GAME.asteroids->rocks.push(Asteroid::create_normal(position, type_int - 1));
     }
 
     int r = GetRandomValue(0, 100);
@@ -252,75 +274,93 @@ void Asteroid::die()
       }
     }
   }
-  else if (type == Type::Crystal)
-  {
-    int pickables_n = 3 + GetRandomValue(1, 5);
-    for (int i = 0; i < pickables_n; i++)
-    {
-      const Vector2 pos{ position.x + static_cast<float>(GetRandomValue(-4 * type_int, 4 * type_int)),
-                         position.y + static_cast<float>(GetRandomValue(-3 * type_int, 3 * type_int)) };
-      const Vector2 vel = Vector2Normalize(
-        Vector2{ static_cast<float>(GetRandomValue(-100, 100)), static_cast<float>(GetRandomValue(-100, 100)) });
-      GAME.pickables->push(Pickable::create_ore(pos, Vector2Add(vel, Vector2Scale(velocity, 0.5f))));
-    }
-  }
 
-  for (int i = 0; i < 20 - std::max(1, type_int * 5); i++)
-  {
-    GAME.particles->push(create_asteroid_particle(position));
-  }
+  ParticleEmitter::emit(Emitter::AsteroidDebris, position, 20 - std::max(1, type_int * 5));
 
   GAME.score += 100 * (3 - type_int);
 }
 
-void Asteroid::draw() const noexcept
+void Asteroid::die_crystal()
 {
-  if (type == Type::AlienShip)
-  {
-    assert(ALIEN_SHIP_SPRITE);
-    ALIEN_SHIP_SPRITE->set_centered();
-    ALIEN_SHIP_SPRITE->position = position;
-
-    draw_wrapped(ALIEN_SHIP_SPRITE->get_destination_rect(),
-                 [&](const Vector2 &P)
-                 {
-                   ALIEN_SHIP_SPRITE->position = P;
-                   ALIEN_SHIP_SPRITE->draw();
-                 });
-  }
-  else if (type == Type::AlienBullet)
+  GAME.event_bus.publish(GameEvent{ .type = GameEvent::Type::AsteroidDestroyed, .value = static_cast<size_t>(type) });
+
+  const uint8_t type_int = static_cast<uint8_t>(type);
+
+  play_explosion_sound(type_int);
+
+  int pickables_n = 3 + GetRandomValue(1, 5);
+  for (int i = 0; i < pickables_n; i++)
   {
-    draw_wrapped(Rectangle{ position.x - 2.0f, position.y - 2.0f, 4.0f, 4.0f },
-                 [&](const Vector2 &P) { DrawCircleV(P, 3.0f, RED); });
+    const Vector2 pos{ position.x + static_cast<float>(GetRandomValue(-4 * type_int, 4 * type_int)),
+                       position.y + static_cast<float>(GetRandomValue(-3 * type_int, 3 * type_int)) };
+    const Vector2 vel = Vector2Normalize(
+      Vector2{ static_cast<float>(GetRandomValue(-100, 100)), static_cast<float>(GetRandomValue(-100, 100)) });
+    GAME.pickables->push(Pickable::create_ore(pos, Vector2Add(vel, Vector2Scale(velocity, 0.5f))));
   }
-  else
-  {
 
-    Color color = DARKPURPLE;
-    assert(ASTEROID_SPRITE);
-    assert(type_tag_map.find(type) != type_tag_map.end());
-
-    ASTEROID_SPRITE->set_centered();
-    ASTEROID_SPRITE->set_tag(type_tag_map[type]);
-    ASTEROID_SPRITE->tint =
-      ColorBrightness(color, 0.5f + static_cast<float>(life) / static_cast<float>(max_life) * 0.5f);
-    ASTEROID_SPRITE->position = position;
-
-    draw_wrapped(ASTEROID_SPRITE->get_destination_rect(),
-                 [&](const Vector2 &P)
-                 {
-                   ASTEROID_SPRITE->position = P;
-                   ASTEROID_SPRITE->draw();
-
-                   if (CONFIG(show_masks))
-                   {
-                     Mask mask_copy     = mask;
-                     mask_copy.position = P;
-                     mask_copy.draw();
-                   }
-                 });
-  }
+  ParticleEmitter::emit(Emitter::AsteroidDebris, position, 20 - std::max(1, type_int * 5));
+}
+
+void Asteroid::die_alien_ship()
+{
+  GAME.event_bus.publish(GameEvent{ .type = GameEvent::Type::AsteroidDestroyed, .value = static_cast<size_t>(type) });
+
+  // NOTE: 1000 for the kill minus the 100 * (3 - type) rock score, which is negative for alien ships
+  GAME.score += 900;
+  ParticleEmitter::emit(Emitter::AlienExplosion, position, 100);
+
+  play_explosion_sound(static_cast<uint8_t>(type));
+}
 
+void Asteroid::draw_alien_ship(RenderQueue &queue) const noexcept
+{
+  assert(ALIEN_SHIP_SPRITE);
+  const Sprite &sprite = *ALIEN_SHIP_SPRITE;
+
+  draw_wrapped(RenderQueue::sprite_bounds(sprite, position),
+               GAME.get_drawn_view(),
+               [&](const Vector2 &P)
+               { queue.push_sprite(RenderLayer::Asteroids, sprite, sprite.get_frame(), P, WHITE); });
+
+  draw_debug();
+}
+
+void Asteroid::draw_alien_bullet(RenderQueue &queue) const noexcept
+{
+  // NOTE: The circle is drawn around the rect position, its extent is the circle diameter
+  draw_wrapped(Rectangle{ position.x - 2.0f, position.y - 2.0f, 6.0f, 6.0f },
+               GAME.get_drawn_view(),
+               [&](const Vector2 &P) { queue.push_circle(RenderLayer::AlienProjectiles, P, 3.0f, RED); });
+
+  draw_debug();
+}
+
+void Asteroid::draw_rock(RenderQueue &queue) const noexcept
+{
+  Color color = DARKPURPLE;
+  assert(ASTEROID_SPRITE);
+  assert(type_tag_map.find(type) != type_tag_map.end());
+
+  const Sprite &sprite = *ASTEROID_SPRITE;
+  const int frame      = sprite.get_tag(type_tag_map[type]).start_frame;
+
+  const Color tint = ColorBrightness(color, 0.5f + static_cast<float>(life) / static_cast<float>(max_life) * 0.5f);
+
+  draw_wrapped(RenderQueue::sprite_bounds(sprite, position),
+               GAME.get_drawn_view(),
+               [&](const Vector2 &P)
+               {
+                 queue.push_sprite(RenderLayer::Asteroids, sprite, frame, P, tint);
+
+                 if (CONFIG(show_masks))
+                   Mask::draw_shape(P, get_shape(), Mask::debug_color(this));
+               });
+
+  draw_debug();
+}
+
+void Asteroid::draw_debug() const noexcept
+{
   if (CONFIG(show_debug))
   {
     DrawPixelV(position, PINK);
@@ -334,3 +374,111 @@ uint8_t Asteroid::size() const noexcept
 {
   return static_cast<uint8_t>(type);
 }
+
+Circle Asteroid::get_shape() const noexcept
+{
+  return TYPE_SHAPES[static_cast<uint8_t>(type)];
+}
+
+bool Asteroid::check_collision(const Mask &other) const
+{
+  return other.check_collision(position, get_shape());
+}
+
+void AsteroidPools::push(Asteroid &&asteroid)
+{
+  switch (asteroid.type)
+  {
+    case Asteroid::Type::Size1:
+    case Asteroid::Type::Size2:
+    case Asteroid::Type::Size3:
+      rocks.push(std::move(asteroid));
+      break;
+    case Asteroid::Type::Crystal:
+      crystals.push(std::move(asteroid));
+      break;
+    case Asteroid::Type::AlienShip:
+      alien_ships.push(std::move(asteroid));
+      break;
+    case Asteroid::Type::AlienBullet:
+      alien_bullets.push(std::move(asteroid));
+      break;
+  }
+}
+
+size_t AsteroidPools::size() const noexcept
+{
+  return rocks.size() + crystals.size() + alien_ships.size() + alien_bullets.size();
+}
+
+bool AsteroidPools::empty() const noexcept
+{
+  return rocks.empty() && crystals.empty() && alien_ships.empty() && alien_bullets.empty();
+}
+
+void AsteroidPools::clear() noexcept
+{
+  rocks.clear();
+  crystals.clear();
+  alien_ships.clear();
+  alien_bullets.clear();
+}
+
+void AsteroidPools::schedule_events(TimingWheel &events)
+{
+  // NOTE: Levels without aliens do not schedule anything
+  if (!alien_ships.empty())
+    events.schedule_repeating(ALIEN_FIRE_PERIOD, []() { GAME.asteroids->fire_alien_ships(); });
+}
+
+void AsteroidPools::fire_alien_ships()
+{
+  if (!GAME.player || GAME.freeze_entities)
+    return;
+
+  const Vector2 player_position = GAME.player->position;
+  alien_ships.for_each(
+    [&](const Asteroid &alien_ship)
+    {
+      if (alien_ship.life <= 0 || GetRandomValue(0, 1) != 0)
+        return;
+
+      const Vector2 direction = Vector2Normalize(Vector2Subtract(player_position, alien_ship.position));
+      Asteroid bullet         = Asteroid::create_alien_bullet(alien_ship.position, direction);
+
+      const uint32_t id = bullet.id;
+      const size_t slot = alien_bullets.push(std::move(bullet));
+      if (slot == decltype(alien_bullets)::NO_SLOT)
+        return;
+
+      // NOTE: The slot may hold a newer bullet by then, the id tells them apart
+      GAME.events->schedule(GetRandomValue(ALIEN_BULLET_MIN_LIFETIME, ALIEN_BULLET_MAX_LIFETIME),
+                            [slot, id]()
+                            {
+                              if (Asteroid *alien_bullet = GAME.asteroids->alien_bullets.get(slot);
+                                  alien_bullet && alien_bullet->id == id)
+                                alien_bullet->life = 0;
+                            });
+    });
+}
+
+void AsteroidPools::update()
+{
+  const bool was_empty = empty();
+
+  rocks.for_each(std::bind(&Asteroid::update_rock, std::placeholders::_1));
+  crystals.for_each(std::bind(&Asteroid::update_crystal, std::placeholders::_1));
+  alien_ships.for_each(std::bind(&Asteroid::update_alien_ship, std::placeholders::_1));
+  alien_bullets.for_each(std::bind(&Asteroid::update_alien_bullet, std::placeholders::_1));
+
+  if (!was_empty && empty())
+    GAME.event_bus.publish(GameEvent{ .type = GameEvent::Type::AsteroidsCleared });
+}
+
+void AsteroidPools::draw(RenderQueue &queue) const noexcept
+{
+  rocks.for_each([&](const Asteroid &asteroid) { asteroid.draw_rock(queue); });
+  crystals.for_each([&](const Asteroid &asteroid) { asteroid.draw_rock(queue); });
+  alien_ships.for_each([&](const Asteroid &asteroid) { asteroid.draw_alien_ship(queue); });
+  alien_bullets.for_each([&](const Asteroid &asteroid) { asteroid.draw_alien_bullet(queue); });
+}
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <type_traits>
+
 #include "raylib.h"
 #include "raymath.h"
 
 #include "mask.hpp"
 #include "object_circular_buffer.hpp"
+#include "render_queue.hpp"
+#include "slot_pool.hpp"
 #include "sound_manager.hpp"
 #include "utils.hpp"
 
+class TimingWheel;
+
 class Asteroid
 {
 public:
@@ -26,27 +32,86 @@ public:
   Type type{ Type::Size3 };
   uint8_t max_life : 4 { 1 };
   uint8_t life : 4 { max_life };
-  Mask mask{};
+  // NOTE: Unique for the lifetime of the game, 0 means no asteroid
+  uint32_t id{ 0 };
 
   [[nodiscard]] static Asteroid create_normal(const Vector2 &position, uint8_t size);
   [[nodiscard]] static Asteroid create_crystal(const Vector2 &position);
   [[nodiscard]] static Asteroid create_alien_ship(const Vector2 &position);
   [[nodiscard]] static Asteroid create_alien_bullet(const Vector2 &position, const Vector2 &direction);
 
-  bool update();
-
-  void draw() const noexcept;
-
   uint8_t size() const noexcept;
 
+  [[nodiscard]] Circle get_shape() const noexcept;
+  [[nodiscard]] bool check_collision(const Mask &other) const;
+
 private:
   Asteroid() = default;
-  void die();
+
+  void move() noexcept;
+  void check_bullets();
+
+  bool update_rock();
+  bool update_crystal();
+  bool update_alien_ship();
+  bool update_alien_bullet();
+
+  void die_rock();
+  void die_crystal();
+  void die_alien_ship();
+
+  void draw_rock(RenderQueue &queue) const noexcept;
+  void draw_alien_ship(RenderQueue &queue) const noexcept;
+  void draw_alien_bullet(RenderQueue &queue) const noexcept;
+  void draw_debug() const noexcept;
 
   DECLARE_FRIEND_OBJECT_CIRCULAR_BUFFER()
+  DECLARE_FRIEND_SLOT_POOL()
 
   static std::unique_ptr<Sprite> ASTEROID_SPRITE;
   static std::unique_ptr<Sprite> ALIEN_SHIP_SPRITE;
 
   friend class Game;
+  friend struct AsteroidPools;
+};
+
+static_assert(std::is_trivially_copyable_v<Asteroid>);
+
+// NOTE: Every behaviour class lives in its own pool and is updated by its own kernel,
+//       queries that do not care about the type go through for_each/size/empty
+struct AsteroidPools
+{
+  ObjectCircularBuffer<Asteroid, 1024> rocks;
+  ObjectCircularBuffer<Asteroid, 64> crystals;
+  ObjectCircularBuffer<Asteroid, 32> alien_ships;
+  // NOTE: Stable slots, the expiry event of a bullet on the timing wheel refers to it by slot and id
+  SlotPool<Asteroid, 256> alien_bullets;
+
+  void push(Asteroid &&asteroid);
+
+  [[nodiscard]] size_t size() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+  void clear() noexcept;
+
+  void update();
+  void draw(RenderQueue &queue) const noexcept;
+
+  void schedule_events(TimingWheel &events);
+  void fire_alien_ships();
+
+  void for_each(auto func)
+  {
+    rocks.for_each(func);
+    crystals.for_each(func);
+    alien_ships.for_each(func);
+    alien_bullets.for_each(func);
+  }
+
+  void for_each(auto func) const
+  {
+    rocks.for_each(func);
+    crystals.for_each(func);
+    alien_ships.for_each(func);
+    alien_bullets.for_each(func);
+  }
 };
@@ -0,0 +1,99 @@
+#include "audio_monitor.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#include <nlohmann/json.hpp>
+
+AudioMonitor::AudioMonitor(bool adaptive)
+  : adaptive(adaptive), buffer_frames(adaptive ? MIN_BUFFER_FRAMES : DEFAULT_BUFFER_FRAMES)
+{
+  ResetAudioDeviceStats();
+}
+
+bool AudioMonitor::update(float dt)
+{
+  sample_timer += dt;
+  if (sample_timer < SAMPLE_PERIOD)
+    return false;
+
+  sample_timer = 0.0f;
+
+  const AudioDeviceStats stats = GetAudioDeviceStats();
+  ResetAudioDeviceStats();
+
+  last_sample = Sample{
+    .callbacks           = stats.callbacks,
+    .callback_frames     = stats.callbackFrames,
+    .average_callback_ms = stats.callbacks > 0 ? stats.totalCallbackTime * 1000.0f / static_cast<float>(stats.callbacks)
+                                               : 0.0f,
+    .max_callback_ms     = stats.maxCallbackTime * 1000.0f,
+    .underruns           = stats.underruns,
+    .underrun_frames     = stats.underrunFrames,
+    .min_queued_frames   = stats.minQueuedFrames == UINT_MAX ? -1 : static_cast<int64_t>(stats.minQueuedFrames),
+  };
+  total_underruns += stats.underruns;
+
+  if (!adaptive || stats.underruns == 0 || buffer_frames >= MAX_BUFFER_FRAMES)
+    return false;
+
+  buffer_frames = std::min(buffer_frames * 2, MAX_BUFFER_FRAMES);
+  buffer_growths++;
+
+  TraceLog(LOG_INFO, "AudioMonitor: %u underruns, music buffer grown to %d frames", stats.underruns, buffer_frames);
+  return true;
+}
+
+void AudioMonitor::draw_debug() const noexcept
+{
+  const int font_size = 10;
+  const int x         = 40;
+  const int y         = GetScreenHeight() - 4 * (font_size + 2) - 10;
+
+  DrawText(TextFormat("Audio buffer: %d frames%s (grown %u times)",
+                      buffer_frames,
+                      adaptive ? " adaptive" : "",
+                      buffer_growths),
+           x,
+           y,
+           font_size,
+           GOLD);
+  DrawText(TextFormat("Callbacks: %u/s of %u frames, %.3fms avg %.3fms max",
+                      last_sample.callbacks,
+                      last_sample.callback_frames,
+                      last_sample.average_callback_ms,
+                      last_sample.max_callback_ms),
+           x,
+           y + font_size + 2,
+           font_size,
+           GOLD);
+  DrawText(TextFormat("Underruns: %u/s (%u frames), %llu total",
+                      last_sample.underruns,
+                      last_sample.underrun_frames,
+                      static_cast<unsigned long long>(total_underruns)),
+           x,
+           y + 2 * (font_size + 2),
+           font_size,
+           last_sample.underruns > 0 ? RED : GOLD);
+  DrawText(TextFormat("Min queued: %lld frames", static_cast<long long>(last_sample.min_queued_frames)),
+           x,
+           y + 3 * (font_size + 2),
+           font_size,
+           GOLD);
+}
+
+nlohmann::json AudioMonitor::to_json() const
+{
+  return nlohmann::json{ { "adaptive", adaptive },
+                         { "buffer_frames", buffer_frames },
+                         { "buffer_growths", buffer_growths },
+                         { "total_underruns", total_underruns },
+                         { "last_sample",
+                           { { "callbacks", last_sample.callbacks },
+                             { "callback_frames", last_sample.callback_frames },
+                             { "average_callback_ms", last_sample.average_callback_ms },
+                             { "max_callback_ms", last_sample.max_callback_ms },
+                             { "underruns", last_sample.underruns },
+                             { "underrun_frames", last_sample.underrun_frames },
+                             { "min_queued_frames", last_sample.min_queued_frames } } } };
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include <nlohmann/json_fwd.hpp>
+#include <raylib.h>
+
+// NOTE: Samples the audio device callback counters once per SAMPLE_PERIOD. In adaptive mode the music stream
+//       buffer starts at MIN_BUFFER_FRAMES and is doubled after every period with underruns, so machines that
+//       keep up get the smallest buffer and slower ones grow it until the music stops crackling.
+class AudioMonitor
+{
+public:
+#if defined(EMSCRIPTEN)
+  // NOTE: Web builds refill the music from the update loop, they keep a large fixed buffer
+  static constexpr const int DEFAULT_BUFFER_FRAMES{ 4096 * 12 };
+  static constexpr const int MIN_BUFFER_FRAMES{ 4096 * 12 };
+#else
+  static constexpr const int DEFAULT_BUFFER_FRAMES{ 4096 };
+  static constexpr const int MIN_BUFFER_FRAMES{ 1024 };
+#endif
+  static constexpr const int MAX_BUFFER_FRAMES{ 4096 * 12 };
+  static constexpr const float SAMPLE_PERIOD{ 1.0f };
+
+  struct Sample
+  {
+    uint32_t callbacks{ 0 };
+    uint32_t callback_frames{ 0 };
+    float average_callback_ms{ 0.0f };
+    float max_callback_ms{ 0.0f };
+    uint32_t underruns{ 0 };
+    uint32_t underrun_frames{ 0 };
+    int64_t min_queued_frames{ -1 }; // -1 when no stream was playing
+  };
+
+  // needs the audio device to be initialized
+  explicit AudioMonitor(bool adaptive);
+
+  // returns true when the buffer grew, the music streams have to be reloaded with get_buffer_frames()
+  [[nodiscard]] bool update(float dt);
+
+  [[nodiscard]] int get_buffer_frames() const noexcept { return buffer_frames; }
+  [[nodiscard]] const Sample &get_last_sample() const noexcept { return last_sample; }
+
+  void draw_debug() const noexcept;
+  [[nodiscard]] nlohmann::json to_json() const;
+
+private:
+  bool adaptive{ false };
+  int buffer_frames{ DEFAULT_BUFFER_FRAMES };
+  float sample_timer{ 0.0f };
+  Sample last_sample;
+  uint64_t total_underruns{ 0 };
+  uint32_t buffer_growths{ 0 };
+};
@@ -0,0 +1,109 @@
+#include "background_layers.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <rlgl.h>
+
+#include "sprite.hpp"
+#include "utils.hpp"
+
+BackgroundLayers::BackgroundLayers(int width, int height, const Sprite &tile_sprite)
+  : tile_sprite(tile_sprite)
+{
+  const int w = static_cast<int>(tile_sprite.get_width());
+  const int h = static_cast<int>(tile_sprite.get_height());
+  tile_size   = Vector2{ static_cast<float>(w), static_cast<float>(h) };
+
+  for (size_t i = 0; i < SINE_TABLE_SIZE; i++)
+    sine_table[i] = static_cast<float>(std::sin(static_cast<double>(i) * 2.0 * M_PI / SINE_TABLE_SIZE));
+
+  // NOTE: Same tiles as the procedural background, the texture origin is one tile above and left of the world
+  for (int x = -w; x <= width + w; x += w)
+  {
+    for (int y = -h; y <= height + h; y += h)
+    {
+      if ((x * y) % 3 == 0 || (x + y) % 5 == 0 || (x * y) % 7 == 0 || (x + y) % 9 == 0)
+        continue;
+
+      const unsigned tile_hash = static_cast<unsigned>(x * 73856093) ^ static_cast<unsigned>(y * 19349663);
+      placements.push_back(Placement{
+        .position = Vector2{ static_cast<float>(x + w), static_cast<float>(y + h) },
+        .frame    = std::clamp((x + y - 1) % 3, 0, tile_sprite.get_frame_count() - 1),
+        .hash     = tile_hash,
+        .layer    = (tile_hash >> 7) % LAYER_COUNT });
+    }
+  }
+
+  for (auto &layer : layers)
+  {
+    layer = LoadRenderTexture(width + 3 * w, height + 3 * h);
+    assert(IsRenderTextureReady(layer));
+  }
+
+  TraceLog(LOG_TRACE, "BackgroundLayers: %zu tiles in %zu layers", placements.size(), LAYER_COUNT);
+}
+
+BackgroundLayers::~BackgroundLayers()
+{
+  for (auto &layer : layers)
+    UnloadRenderTexture(layer);
+}
+
+void BackgroundLayers::bake(int density)
+{
+  if (density == baked_density)
+    return;
+
+  baked_density = density;
+
+  // NOTE: Output is premultiplied so the layers keep the sprite edges when they are blended over the stars
+  rlSetBlendFactorsSeparate(
+    RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+  for (size_t i = 0; i < LAYER_COUNT; i++)
+  {
+    BeginTextureMode(layers[i]);
+    ClearBackground(BLANK);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+    // NOTE: Lower quality levels drop a stable subset of the tiles, so the remaining ones do not flicker
+    for (const auto &placement : placements)
+    {
+      if (placement.layer != i || static_cast<int>(placement.hash % 100) >= density)
+        continue;
+
+      DrawTextureRec(tile_sprite.get_texture(), tile_sprite.get_frame_rect(placement.frame), placement.position, TINT);
+    }
+
+    EndBlendMode();
+    EndTextureMode();
+  }
+
+  TraceLog(LOG_TRACE, "BackgroundLayers: baked with density %d", density);
+}
+
+void BackgroundLayers::draw(uint64_t revision) const noexcept
+{
+  // NOTE: Animated by the world revision instead of the frame, so the layers do not jump after a dialog
+  const double t = static_cast<double>(revision);
+
+  BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+  for (size_t i = 0; i < LAYER_COUNT; i++)
+  {
+    const double phase = static_cast<double>(i) * 2.0 * M_PI / static_cast<double>(LAYER_COUNT);
+    const float x      = -tile_size.x - sine(t * 0.001 + phase) * tile_size.x * 0.5f;
+    const float y      = -tile_size.y - sine(t * 0.002 - phase + M_PI * 0.5) * tile_size.y * 0.8f;
+
+    const Texture2D &texture = layers[i].texture;
+    DrawTextureRec(texture, texture_rect_flipped(texture), Vector2{ std::round(x), std::round(y) }, WHITE);
+  }
+  EndBlendMode();
+}
+
+float BackgroundLayers::sine(double phase) const noexcept
+{
+  const double turns = phase / (2.0 * M_PI) * static_cast<double>(SINE_TABLE_SIZE);
+  const auto index   = static_cast<int64_t>(std::floor(turns));
+  return sine_table[static_cast<size_t>(index) & (SINE_TABLE_SIZE - 1)];
+}
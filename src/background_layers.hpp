@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+class Sprite;
+
+// NOTE: The asteroid tiles behind the world, baked into a few render textures that drift independently.
+//       Tile placement is computed once, the textures are only baked again when the density changes, and
+//       every frame draws one quad per layer with its drift read from a sine table.
+class BackgroundLayers
+{
+public:
+  static constexpr const size_t LAYER_COUNT{ 4 };
+  static constexpr const size_t SINE_TABLE_SIZE{ 1024 }; // power of two
+  static constexpr const Color TINT{ 51, 51, 51, 255 };  // ColorBrightness(BLACK, 0.2f)
+
+  BackgroundLayers(int width, int height, const Sprite &tile_sprite);
+  ~BackgroundLayers();
+
+  BackgroundLayers(const BackgroundLayers &)            = delete;
+  BackgroundLayers &operator=(const BackgroundLayers &) = delete;
+
+  // bakes the layers when density (percent of tiles kept) changed, must not be called inside a texture mode
+  void bake(int density);
+  // draws the layers drifted to the world revision
+  void draw(uint64_t revision) const noexcept;
+
+private:
+  struct Placement
+  {
+    Vector2 position{}; // in the layer texture
+    int frame{ 0 };
+    unsigned hash{ 0 };
+    size_t layer{ 0 };
+  };
+
+  [[nodiscard]] float sine(double phase) const noexcept;
+
+  const Sprite &tile_sprite;
+  Vector2 tile_size{};
+  std::vector<Placement> placements;
+  std::array<RenderTexture2D, LAYER_COUNT> layers{};
+  std::array<float, SINE_TABLE_SIZE> sine_table{};
+  int baked_density{ -1 };
+};
@@ -1,8 +1,10 @@
 #include "bullet.hpp"
 
 #include "asteroid.hpp"
+#include "emitter.hpp"
 #include "game.hpp"
 #include "particle.hpp"
+#include "targeting.hpp"
 #include "utils.hpp"
 
 Bullet Bullet::create_normal(const Vector2 &position, const Vector2 &velocity)
@@ -20,25 +22,9 @@ Bullet Bullet::create_normal(const Vector2 &position, const Vector2 &velocity)
 static Vector2 DEBUG_asteroid_position;
 #endif
 
-const Asteroid &get_nearest_asteroid(const Vector2 &position)
-{
-  auto &asteroids                  = GAME.asteroids;
-  const Asteroid *nearest_asteroid = &asteroids->objects[0];
-  float nearest_distance{ std::numeric_limits<float>::max() };
-
-  asteroids->for_each(
-    [&](const Asteroid &asteroid)
-    {
-      const float distance = Vector2Distance(position, asteroid.position);
-      if (distance < nearest_distance)
-      {
-        nearest_asteroid = &asteroid;
-        nearest_distance = distance;
-      }
-    });
-
-  return *nearest_asteroid;
-}
+static constexpr const float HOMING_RANGE{ 200.0f };
+// NOTE: cos(60deg), homing bullets only re-acquire targets in front of them
+static constexpr const float HOMING_CONE_COS{ 0.5f };
 
 Bullet Bullet::create_assisted(const Vector2 &position, const Vector2 &velocity)
 {
@@ -47,10 +33,14 @@ Bullet Bullet::create_assisted(const Vector2 &position, const Vector2 &velocity)
   bullet.velocity        = velocity;
   Vector2 check_position = Vector2Add(position, Vector2Scale(velocity, 10.0f));
 
+  const Target *nearest_target = GAME.targets->nearest(check_position);
+  const Vector2 target_position =
+    nearest_target ? Vector2Add(position, TargetIndex::wrapped_delta(position, nearest_target->position))
+                   : Vector2Add(position, velocity);
 #if defined(DEBUG)
-  DEBUG_asteroid_position = get_nearest_asteroid(check_position).position;
+  DEBUG_asteroid_position = target_position;
 #endif
-  bullet.direction = Vector2Normalize(Vector2Subtract(get_nearest_asteroid(check_position).position, position));
+  bullet.direction = Vector2Normalize(Vector2Subtract(target_position, position));
   bullet.type      = BulletType::Assisted;
   bullet.life      = 40;
   return bullet;
@@ -59,11 +49,18 @@ Bullet Bullet::create_assisted(const Vector2 &position, const Vector2 &velocity)
 Bullet Bullet::create_homing(const Vector2 &position, [[maybe_unused]] const Vector2 &velocity)
 {
   Bullet bullet;
-  bullet.position        = position;
-  bullet.direction       = Vector2Normalize(velocity);
-  auto &nearest_asteroid = get_nearest_asteroid(position);
-  if (nearest_asteroid.life > 0)
-    bullet.target = &nearest_asteroid.position;
+  bullet.position  = position;
+  bullet.direction = Vector2Normalize(velocity);
+
+  // NOTE: Alien ships shoot back, homing bullets go for one first when it is in range
+  const Target *nearest_target = GAME.targets->nearest_of_type(position, Asteroid::Type::AlienShip, HOMING_RANGE);
+  if (!nearest_target)
+    nearest_target = GAME.targets->nearest(position);
+  if (nearest_target)
+  {
+    bullet.target_id       = nearest_target->id;
+    bullet.target_position = nearest_target->position;
+  }
   bullet.type = BulletType::Homing;
   bullet.life = 20;
   return bullet;
@@ -71,16 +68,9 @@ Bullet Bullet::create_homing(const Vector2 &position, [[maybe_unused]] const Vec
 
 bool Bullet::update()
 {
-  const Color particle_color{ 255, 100, 255, 80 };
-
   if (life == 0)
   {
-    const size_t number_of_particles = 5;
-    for (size_t i = 0; i < number_of_particles; ++i)
-    {
-      const Vector2 velocity{ GetRandomValue(-100, 100) / 100.0f, GetRandomValue(-100, 100) / 100.0f };
-      GAME.particles->push(Particle::create(position, velocity, particle_color));
-    }
+    ParticleEmitter::emit(Emitter::BulletBurst, position, 5);
     return false;
   }
 
@@ -91,9 +81,9 @@ bool Bullet::update()
 
     velocity = Vector2Scale(Vector2Normalize(velocity), 5.0f);
   }
-  else if (type == BulletType::Homing && target != nullptr)
+  else if (type == BulletType::Homing && acquire_target())
   {
-    direction = Vector2Normalize(Vector2Subtract(get_target_position(), position));
+    direction = Vector2Normalize(TargetIndex::wrapped_delta(position, target_position));
 
     velocity.x += direction.x * 2.0f;
     velocity.y += direction.y * 2.0f;
@@ -112,22 +102,25 @@ bool Bullet::update()
   if (type == BulletType::Homing)
     particles_per_frame = 1;
   if (life % particles_per_frame == 0)
-  {
-    GAME.particles->push(Particle::create(position, Vector2{ 0.0f, 0.0f }, particle_color));
-  }
+    ParticleEmitter::emit(Emitter::BulletTrail, position, 1);
 
   return true;
 }
 
-void Bullet::draw() const noexcept
+void Bullet::draw(RenderQueue &queue) const noexcept
 {
   Color color{ PINK };
 
   if (type == BulletType::Homing)
     color = ORANGE;
 
-  draw_wrapped(Rectangle{ position.x, position.y, 2.0f, 2.0f },
-               [&](const Vector2 &P) { DrawCircle(P.x, P.y, 2.0f, color); });
+  draw_wrapped(Rectangle{ position.x, position.y, 4.0f, 4.0f },
+               GAME.get_drawn_view(),
+               [&](const Vector2 &P)
+               {
+                 const Vector2 center{ std::trunc(P.x), std::trunc(P.y) };
+                 queue.push_circle(RenderLayer::Projectiles, center, 2.0f, color);
+               });
 
 #if defined(DEBUG)
   if (CONFIG(debug_bullets))
@@ -135,7 +128,7 @@ void Bullet::draw() const noexcept
     DrawCircleV(DEBUG_asteroid_position, 2.0f, RED);
     DrawCircleLinesV(DEBUG_asteroid_position, 20.0f, RED);
 
-    if (target)
+    if (target_id != 0)
     {
       DrawCircleV(get_target_position(), 2.0f, RED);
       DrawCircleLinesV(get_target_position(), 20.0f, RED);
@@ -146,7 +139,24 @@ void Bullet::draw() const noexcept
 
 Vector2 Bullet::get_target_position() const noexcept
 {
-  if (target)
-    return *target;
+  if (target_id != 0)
+    return target_position;
   return position;
 }
+
+bool Bullet::acquire_target() noexcept
+{
+  const Target *target = GAME.targets->find(target_id);
+  if (!target)
+    target = GAME.targets->nearest_in_cone(position, direction, HOMING_CONE_COS, HOMING_RANGE);
+
+  if (!target)
+  {
+    target_id = 0;
+    return false;
+  }
+
+  target_id       = target->id;
+  target_position = target->position;
+  return true;
+}
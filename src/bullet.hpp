@@ -1,9 +1,12 @@
 #pragma once
 
+#include <type_traits>
+
 #include "raylib.h"
 #include "raymath.h"
 
 #include "object_circular_buffer.hpp"
+#include "render_queue.hpp"
 #include "utils.hpp"
 
 enum class BulletType : uint8_t
@@ -28,12 +31,18 @@ public:
   Vector2 get_target_position() const noexcept;
 
   bool update();
-  void draw() const noexcept;
+  void draw(RenderQueue &queue) const noexcept;
 
 private:
   Bullet() = default;
 
-  const Vector2 *target{ nullptr };
+  bool acquire_target() noexcept;
+
+  // NOTE: Homing bullets look their target up by id every tick and pick a new one when it is gone
+  uint32_t target_id{ 0 };
+  Vector2 target_position{};
 
   DECLARE_FRIEND_OBJECT_CIRCULAR_BUFFER()
 };
+
+static_assert(std::is_trivially_copyable_v<Bullet>);
@@ -37,6 +37,12 @@ bool Dialog::is_introduced(const std::string &name)
   return introduced[name];
 }
 
+void Dialog::introduce(const std::string &name)
+{
+  introduced.insert_or_assign(name, true);
+  GAME.event_bus.publish(GameEvent{ .type = GameEvent::Type::CharacterIntroduced, .name = name });
+}
+
 std::unordered_map<DialogId, Dialog> Dialog::load_dialogs(const std::string &name)
 {
   static std::unordered_map<std::string, DialogMap> dialogs;
@@ -50,7 +56,7 @@ std::unordered_map<DialogId, Dialog> Dialog::load_dialogs(const std::string &nam
                 "Greetings, I am the Captain. I've been expecting you.\n"
                 "Do you have a moment to discuss?",
                 {
-                  { "Yes, let's talk", "name", []() { introduced.insert_or_assign("Captain", true); } },
+                  { "Yes, let's talk", "name", []() { introduce("Captain"); } },
                   { "I'm busy, goodbye", "_end" },
                 },
                 []() -> std::optional<DialogId>
@@ -214,7 +220,7 @@ std::unordered_map<DialogId, Dialog> Dialog::load_dialogs(const std::string &nam
                                        },
                                        []() -> std::optional<DialogId>
                                        {
-                                         introduced.insert_or_assign("Mechanic", true);
+                                         introduce("Mechanic");
 
                                          if (!is_introduced("Captain"))
                                            return "about_captain";
@@ -377,7 +383,7 @@ std::unordered_map<DialogId, Dialog> Dialog::load_dialogs(const std::string &nam
         Dialog{ "Scientist",
                 "Hello! How are you?",
                 {
-                  { "I'm fine, thanks", "quest1_intro", []() { introduced.insert_or_assign("Scientist", true); } },
+                  { "I'm fine, thanks", "quest1_intro", []() { introduce("Scientist"); } },
                 },
                 []() -> std::optional<DialogId>
                 {
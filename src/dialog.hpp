@@ -57,6 +57,8 @@ struct Dialog
 
   static std::unordered_map<std::string, bool> introduced;
   [[nodiscard]] static bool is_introduced(const std::string &name);
+  // NOTE: Publishes CharacterIntroduced, introduced is only written through this
+  static void introduce(const std::string &name);
 
 private:
 };
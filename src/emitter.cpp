@@ -0,0 +1,226 @@
+#include "emitter.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <raymath.h>
+
+#include "game.hpp"
+#include "quality_governor.hpp"
+#include "utils.hpp"
+
+static constexpr const size_t PALETTE_SIZE{ 32 };
+static constexpr const size_t DIRECTION_COUNT{ 64 };
+
+static_assert((PALETTE_SIZE & (PALETTE_SIZE - 1)) == 0);
+static_assert((DIRECTION_COUNT & (DIRECTION_COUNT - 1)) == 0);
+
+enum class VelocityMode : uint8_t
+{
+  Inherit,         // only the scaled emitter velocity
+  RandomDirection, // unit vector in a random direction
+  RandomBox        // uniform in [-random_speed, random_speed] on both axes
+};
+
+struct EmitterPreset
+{
+  float position_jitter{ 0.0f };
+  float inherit_velocity{ 1.0f };
+  VelocityMode velocity_mode{ VelocityMode::Inherit };
+  float random_speed{ 1.0f };
+  std::array<Color, PALETTE_SIZE> palette{};
+};
+
+struct FastRandom
+{
+  uint32_t state{ 0x9E3779B9u };
+
+  uint32_t next() noexcept
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  // uniform in [0, 1)
+  float unit() noexcept { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+  // uniform in [-1, 1]
+  float signed_unit() noexcept { return static_cast<float>(next() >> 8) * (2.0f / 16777216.0f) - 1.0f; }
+};
+
+static std::array<Color, PALETTE_SIZE> single_color_palette(const Color &color)
+{
+  std::array<Color, PALETTE_SIZE> palette;
+  palette.fill(color);
+  return palette;
+}
+
+static std::array<Color, PALETTE_SIZE> asteroid_palette(unsigned char alpha)
+{
+  std::array<Color, PALETTE_SIZE> palette;
+  for (auto &color : palette)
+  {
+    const float hue        = 229.0f - 10.0f + static_cast<float>(GetRandomValue(0, 20));
+    const float saturation = 0.3f + static_cast<float>(GetRandomValue(0, 10)) / 100.0f;
+    const float value      = 0.1f + static_cast<float>(GetRandomValue(0, 50)) / 100.0f;
+    color                  = ColorFromHSV(hue, saturation, value);
+    color.a                = alpha;
+  }
+  return palette;
+}
+
+static std::array<Color, PALETTE_SIZE> random_palette()
+{
+  std::array<Color, PALETTE_SIZE> palette;
+  for (auto &color : palette)
+  {
+    color = Color{ static_cast<unsigned char>(GetRandomValue(0, 255)),
+                   static_cast<unsigned char>(GetRandomValue(0, 255)),
+                   static_cast<unsigned char>(GetRandomValue(0, 255)),
+                   static_cast<unsigned char>(GetRandomValue(0, 255)) };
+  }
+  return palette;
+}
+
+static std::array<EmitterPreset, static_cast<size_t>(Emitter::Count)> create_presets()
+{
+  const Color bullet_color{ 255, 100, 255, 80 };
+
+  std::array<EmitterPreset, static_cast<size_t>(Emitter::Count)> presets;
+  auto preset = [&presets](Emitter emitter) -> EmitterPreset & { return presets[static_cast<size_t>(emitter)]; };
+
+  preset(Emitter::AsteroidDebris) = EmitterPreset{ .position_jitter  = 10.0f,
+                                                   .inherit_velocity = 0.0f,
+                                                   .velocity_mode    = VelocityMode::RandomDirection,
+                                                   .palette          = asteroid_palette(255) };
+
+  preset(Emitter::AsteroidDust) = EmitterPreset{ .position_jitter  = 10.0f,
+                                                 .inherit_velocity = 0.0f,
+                                                 .velocity_mode    = VelocityMode::RandomDirection,
+                                                 .palette          = asteroid_palette(100) };
+
+  preset(Emitter::AlienExplosion) = EmitterPreset{ .inherit_velocity = 0.0f,
+                                                   .velocity_mode    = VelocityMode::RandomBox,
+                                                   .palette          = single_color_palette(Color{ 200, 255, 55, 250 }) };
+
+  preset(Emitter::AlienBulletTrail) = EmitterPreset{ .inherit_velocity = 0.5f,
+                                                     .palette          = single_color_palette(ColorAlpha(RED, 0.9f)) };
+
+  preset(Emitter::BulletTrail) = EmitterPreset{ .inherit_velocity = 0.0f,
+                                                .palette          = single_color_palette(bullet_color) };
+
+  preset(Emitter::BulletBurst) = EmitterPreset{ .inherit_velocity = 0.0f,
+                                                .velocity_mode    = VelocityMode::RandomBox,
+                                                .palette          = single_color_palette(bullet_color) };
+
+  preset(Emitter::MuzzleFlash) = EmitterPreset{ .position_jitter  = 2.0f,
+                                                .inherit_velocity = 0.99f,
+                                                .palette          = single_color_palette(Color{ 255, 109, 194, 120 }) };
+
+  preset(Emitter::MuzzleGlow) = EmitterPreset{ .position_jitter  = 2.0f,
+                                               .inherit_velocity = 0.2f,
+                                               .palette          = single_color_palette(Color{ 255, 109, 194, 20 }) };
+
+  preset(Emitter::EngineExhaust) = EmitterPreset{ .position_jitter  = 2.0f,
+                                                  .inherit_velocity = 1.0f,
+                                                  .palette          = single_color_palette(Color{ 255, 255, 255, 40 }) };
+
+  preset(Emitter::EngineSmoke) = EmitterPreset{ .position_jitter  = 2.0f,
+                                                .inherit_velocity = 0.5f,
+                                                .palette          = single_color_palette(Color{ 127, 106, 79, 80 }) };
+
+  preset(Emitter::ShipDebris) = EmitterPreset{ .position_jitter  = 20.0f,
+                                               .inherit_velocity = 0.0f,
+                                               .velocity_mode    = VelocityMode::RandomDirection,
+                                               .palette          = single_color_palette(ColorBrightness(BLACK, 0.1f)) };
+
+  preset(Emitter::ShipExplosion) = EmitterPreset{ .position_jitter  = 10.0f,
+                                                  .inherit_velocity = 0.0f,
+                                                  .velocity_mode    = VelocityMode::RandomDirection,
+                                                  .palette          = single_color_palette(Color{ 250, 200, 120, 240 }) };
+
+  preset(Emitter::ArtifactTrail) = EmitterPreset{ .inherit_velocity = 0.0f,
+                                                  .palette          = single_color_palette(Color{ 10, 255, 255, 200 }) };
+
+  preset(Emitter::Ambient) = EmitterPreset{ .inherit_velocity = 0.0f,
+                                            .velocity_mode    = VelocityMode::RandomBox,
+                                            .palette          = random_palette() };
+
+  return presets;
+}
+
+static std::array<Vector2, DIRECTION_COUNT> create_directions()
+{
+  std::array<Vector2, DIRECTION_COUNT> directions;
+  for (size_t i = 0; i < DIRECTION_COUNT; i++)
+  {
+    const float angle = static_cast<float>(i) / static_cast<float>(DIRECTION_COUNT) * 2.0f * PI;
+    directions[i]     = Vector2{ cosf(angle), sinf(angle) };
+  }
+  return directions;
+}
+
+void ParticleEmitter::emit(Emitter emitter, const Vector2 &position, size_t count, const Vector2 &velocity)
+{
+  if (GAME.particles)
+    emit(*GAME.particles, emitter, position, count, velocity);
+}
+
+void ParticleEmitter::emit(ParticleBuffer &particles,
+                           Emitter emitter,
+                           const Vector2 &position,
+                           size_t count,
+                           const Vector2 &velocity)
+{
+  static const auto PRESETS    = create_presets();
+  static const auto DIRECTIONS = create_directions();
+  static FastRandom random{ static_cast<uint32_t>(GetRandomValue(1, std::numeric_limits<int>::max())) };
+
+  // NOTE: Fractional counts are rounded randomly, so single particle trails thin out instead of vanishing
+  if (GAME.quality)
+  {
+    const float scaled_count = static_cast<float>(count) * GAME.quality->settings().particle_spawn_rate;
+    count                    = static_cast<size_t>(scaled_count);
+    if (random.unit() < scaled_count - static_cast<float>(count))
+      count++;
+  }
+
+  const EmitterPreset &preset = PRESETS[static_cast<size_t>(emitter)];
+  const Vector2 base_velocity = Vector2Scale(velocity, preset.inherit_velocity);
+  const float jitter          = preset.position_jitter;
+
+  particles.push_n(count,
+                   [&](size_t)
+                   {
+                     Vector2 particle_position = position;
+                     if (jitter > 0.0f)
+                     {
+                       particle_position.x += std::round(random.signed_unit() * jitter);
+                       particle_position.y += std::round(random.signed_unit() * jitter);
+                     }
+
+                     Vector2 particle_velocity = base_velocity;
+                     switch (preset.velocity_mode)
+                     {
+                       case VelocityMode::Inherit:
+                         break;
+                       case VelocityMode::RandomDirection:
+                       {
+                         const Vector2 &direction = DIRECTIONS[random.next() & (DIRECTION_COUNT - 1)];
+                         particle_velocity.x += direction.x * preset.random_speed;
+                         particle_velocity.y += direction.y * preset.random_speed;
+                         break;
+                       }
+                       case VelocityMode::RandomBox:
+                         particle_velocity.x += random.signed_unit() * preset.random_speed;
+                         particle_velocity.y += random.signed_unit() * preset.random_speed;
+                         break;
+                     }
+
+                     const Color &color = preset.palette[random.next() & (PALETTE_SIZE - 1)];
+                     return Particle::create(particle_position, particle_velocity, color);
+                   });
+}
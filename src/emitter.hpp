@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <raylib.h>
+
+#include "object_circular_buffer.hpp"
+#include "particle.hpp"
+
+enum class Emitter : uint8_t
+{
+  AsteroidDebris,
+  AsteroidDust,
+  AlienExplosion,
+  AlienBulletTrail,
+  BulletTrail,
+  BulletBurst,
+  MuzzleFlash,
+  MuzzleGlow,
+  EngineExhaust,
+  EngineSmoke,
+  ShipDebris,
+  ShipExplosion,
+  ArtifactTrail,
+  Ambient,
+  Count
+};
+
+// NOTE: Particle bursts described by named presets. Colours are precomputed into palettes and random
+//       values come from a cheap xorshift generator, so a burst of N particles is one bulk append
+//       into the particle buffer instead of N calls to ColorFromHSV and GetRandomValue.
+class ParticleEmitter
+{
+public:
+  // velocity is scaled by the preset and added to the random velocity of every particle
+  static void emit(Emitter emitter, const Vector2 &position, size_t count, const Vector2 &velocity = Vector2{});
+  static void emit(ParticleBuffer &particles,
+                   Emitter emitter,
+                   const Vector2 &position,
+                   size_t count,
+                   const Vector2 &velocity = Vector2{});
+};
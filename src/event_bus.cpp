@@ -0,0 +1,24 @@
+#include "event_bus.hpp"
+
+#include <cassert>
+#include <utility>
+
+void EventBus::subscribe(GameEvent::Type type, Handler &&handler)
+{
+  assert(static_cast<size_t>(type) < GameEvent::TYPE_COUNT);
+  handlers[static_cast<size_t>(type)].push_back(std::move(handler));
+}
+
+void EventBus::publish(const GameEvent &event)
+{
+  // NOTE: Indexed, a handler may subscribe another one while the event is published
+  const auto &type_handlers = handlers[static_cast<size_t>(event.type)];
+  for (size_t i = 0; i < type_handlers.size(); i++)
+    type_handlers[i](event);
+}
+
+void EventBus::clear() noexcept
+{
+  for (auto &type_handlers : handlers)
+    type_handlers.clear();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+struct GameEvent
+{
+  enum class Type : uint8_t
+  {
+    CrystalsChanged,     // value: crystals held after the change
+    AsteroidDestroyed,   // value: Asteroid::Type of the destroyed one, once per destruction
+    AsteroidsCleared,    // the last asteroid of the level is gone
+    ArtifactFound,       // value: artifacts held
+    MissionUnlocked,     // value: mission number
+    CharacterIntroduced, // name: the character
+  };
+  static constexpr const size_t TYPE_COUNT{ 6 };
+
+  Type type{ Type::CrystalsChanged };
+  size_t value{ 0 };
+  std::string_view name{}; // only valid during publish()
+};
+
+// NOTE: Synchronous publish/subscribe of gameplay events. Handlers are stored per event type, so publishing
+//       only runs the ones subscribed to that type and nothing runs while nothing happens.
+class EventBus
+{
+public:
+  using Handler = std::function<void(const GameEvent &event)>;
+
+  void subscribe(GameEvent::Type type, Handler &&handler);
+  // runs the handlers of event.type in subscription order
+  void publish(const GameEvent &event);
+  void clear() noexcept;
+
+private:
+  std::array<std::vector<Handler>, GameEvent::TYPE_COUNT> handlers;
+};
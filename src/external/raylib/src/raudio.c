@@ -180,6 +180,7 @@ typedef struct tagBITMAPINFOHEADER {
 #include <stdlib.h>                     // Required for: malloc(), free()
 #include <stdio.h>                      // Required for: FILE, fopen(), fclose(), fread()
 #include <string.h>                     // Required for: strcmp() [Used in IsFileExtension(), LoadWaveFromMemory(), LoadMusicStreamFromMemory()]
+#include <limits.h>                     // Required for: UINT_MAX [Used in AudioDeviceStats]
 
 #if defined(RAUDIO_STANDALONE)
     #ifndef TRACELOG
@@ -355,6 +356,7 @@ struct rAudioBuffer {
     int usage;                      // Audio buffer usage mode: STATIC or STREAM
 
     bool isSubBufferProcessed[2];   // SubBuffer processed (virtual double buffer)
+    bool isFilled;                  // Stream written since it was started, an empty one before is not an underrun
     unsigned int sizeInFrames;      // Total buffer size in frames
     unsigned int frameCursorPos;    // Frame cursor position
     unsigned int framesProcessed;   // Total frames processed in this buffer (required for play timing)
@@ -406,6 +408,9 @@ static AudioData AUDIO = {          // Global AUDIO context
     .mixedProcessor = NULL
 };
 
+static AudioDeviceStats AUDIO_STATS = { .minQueuedFrames = UINT_MAX };   // Written by the device callback, under AUDIO.System.lock
+static ma_timer AUDIO_STATS_TIMER = { 0 };
+
 //----------------------------------------------------------------------------------
 // Module specific Functions Declaration
 //----------------------------------------------------------------------------------
@@ -446,6 +451,8 @@ void UntrackAudioBuffer(AudioBuffer *buffer);
 // Initialize audio device
 void InitAudioDevice(void)
 {
+    ma_timer_init(&AUDIO_STATS_TIMER);
+
     // Init audio context
     ma_context_config ctxConfig = ma_context_config_init();
     ma_log_callback_init(OnLog, NULL);
@@ -653,6 +660,7 @@ void StopAudioBuffer(AudioBuffer *buffer)
             buffer->framesProcessed = 0;
             buffer->isSubBufferProcessed[0] = true;
             buffer->isSubBufferProcessed[1] = true;
+            buffer->isFilled = false;
         }
     }
 }
@@ -2139,6 +2147,7 @@ void UpdateAudioStream(AudioStream stream, const void *data, int frameCount)
                 if (leftoverFrameCount > 0) memset(subBuffer + bytesToWrite, 0, leftoverFrameCount*stream.channels*(stream.sampleSize/8));
 
                 stream.buffer->isSubBufferProcessed[subBufferToUpdate] = false;
+                stream.buffer->isFilled = true;
             }
             else TRACELOG(LOG_WARNING, "STREAM: Attempting to write too many frames to buffer");
         }
@@ -2202,6 +2211,29 @@ void SetAudioStreamPan(AudioStream stream, float pan)
     SetAudioBufferPan(stream.buffer, pan);
 }
 
+// Get audio device callback counters
+AudioDeviceStats GetAudioDeviceStats(void)
+{
+    AudioDeviceStats stats = { 0 };
+
+    ma_mutex_lock(&AUDIO.System.lock);
+    stats = AUDIO_STATS;
+    ma_mutex_unlock(&AUDIO.System.lock);
+
+    return stats;
+}
+
+// Reset audio device callback counters
+void ResetAudioDeviceStats(void)
+{
+    AudioDeviceStats stats = { 0 };
+    stats.minQueuedFrames = UINT_MAX;
+
+    ma_mutex_lock(&AUDIO.System.lock);
+    AUDIO_STATS = stats;
+    ma_mutex_unlock(&AUDIO.System.lock);
+}
+
 // Default size for new audio streams
 void SetAudioStreamBufferSizeDefault(int size)
 {
@@ -2417,6 +2449,14 @@ static ma_uint32 ReadAudioBufferFramesInInternalFormat(AudioBuffer *audioBuffer,
     {
         memset((unsigned char *)framesOut + (framesRead*frameSizeInBytes), 0, totalFramesRemaining*frameSizeInBytes);
 
+        // A playing stream without enough queued frames is an underrun, the refill came too late.
+        // Reads between playing a stream and its first refill are not counted, nothing was late yet
+        if ((audioBuffer->usage == AUDIO_BUFFER_USAGE_STREAM) && audioBuffer->isFilled)
+        {
+            AUDIO_STATS.underruns++;
+            AUDIO_STATS.underrunFrames += totalFramesRemaining;
+        }
+
         // For static buffers we can fill the remaining frames with silence for safety, but we don't want
         // to report those frames as "read". The reason for this is that the caller uses the return value
         // to know whether a non-looping sound has finished playback.
@@ -2485,12 +2525,29 @@ static void OnSendAudioDataToDevice(ma_device *pDevice, void *pFramesOut, const
     // Using a mutex here for thread-safety which makes things not real-time
     // This is unlikely to be necessary for this project, but may want to consider how you might want to avoid this
     ma_mutex_lock(&AUDIO.System.lock);
+    const double callbackStart = ma_timer_get_time_in_seconds(&AUDIO_STATS_TIMER);
     {
         for (AudioBuffer *audioBuffer = AUDIO.Buffer.first; audioBuffer != NULL; audioBuffer = audioBuffer->next)
         {
             // Ignore stopped or paused sounds
             if (!audioBuffer->playing || audioBuffer->paused) continue;
 
+            // Frames the stream still has queued in its unprocessed sub-buffers
+            if ((audioBuffer->usage == AUDIO_BUFFER_USAGE_STREAM) && (audioBuffer->callback == NULL) && (audioBuffer->sizeInFrames > 1) && audioBuffer->isFilled)
+            {
+                ma_uint32 subBufferSizeInFrames = audioBuffer->sizeInFrames/2;
+                ma_uint32 currentSubBufferIndex = audioBuffer->frameCursorPos/subBufferSizeInFrames;
+                ma_uint32 queuedFrames = 0;
+
+                if (currentSubBufferIndex <= 1)
+                {
+                    if (!audioBuffer->isSubBufferProcessed[currentSubBufferIndex]) queuedFrames += subBufferSizeInFrames - (audioBuffer->frameCursorPos - currentSubBufferIndex*subBufferSizeInFrames);
+                    if (!audioBuffer->isSubBufferProcessed[1 - currentSubBufferIndex]) queuedFrames += subBufferSizeInFrames;
+                }
+
+                if (queuedFrames < AUDIO_STATS.minQueuedFrames) AUDIO_STATS.minQueuedFrames = queuedFrames;
+            }
+
             ma_uint32 framesRead = 0;
 
             while (1)
@@ -2568,6 +2625,13 @@ static void OnSendAudioDataToDevice(ma_device *pDevice, void *pFramesOut, const
         processor = processor->next;
     }
 
+    const float callbackTime = (float)(ma_timer_get_time_in_seconds(&AUDIO_STATS_TIMER) - callbackStart);
+    AUDIO_STATS.callbacks++;
+    AUDIO_STATS.callbackFrames = frameCount;
+    AUDIO_STATS.lastCallbackTime = callbackTime;
+    AUDIO_STATS.totalCallbackTime += callbackTime;
+    if (callbackTime > AUDIO_STATS.maxCallbackTime) AUDIO_STATS.maxCallbackTime = callbackTime;
+
     ma_mutex_unlock(&AUDIO.System.lock);
 }
 
@@ -473,6 +473,18 @@ typedef struct Music {
     void *ctxData;              // Audio context data, depends on type
 } Music;
 
+// AudioDeviceStats, audio device callback counters, accumulated until ResetAudioDeviceStats()
+typedef struct AudioDeviceStats {
+    unsigned int callbacks;         // Device callbacks
+    unsigned int callbackFrames;    // Frames requested by the last callback
+    float lastCallbackTime;         // Duration of the last callback (seconds)
+    float maxCallbackTime;          // Longest callback (seconds)
+    float totalCallbackTime;        // Time spent in callbacks (seconds)
+    unsigned int underruns;         // Stream reads that ran out of queued frames and were filled with silence
+    unsigned int underrunFrames;    // Frames of silence inserted by underruns
+    unsigned int minQueuedFrames;   // Fewest frames queued in a playing stream when a callback started (UINT_MAX: none)
+} AudioDeviceStats;
+
 // VrDeviceInfo, Head-Mounted-Display device parameters
 typedef struct VrDeviceInfo {
     int hResolution;                // Horizontal resolution in pixels
@@ -1649,6 +1661,9 @@ RLAPI void SetAudioStreamPan(AudioStream stream, float pan);          // Set pan
 RLAPI void SetAudioStreamBufferSizeDefault(int size);                 // Default size for new audio streams
 RLAPI void SetAudioStreamCallback(AudioStream stream, AudioCallback callback); // Audio thread callback to request new data
 
+RLAPI AudioDeviceStats GetAudioDeviceStats(void);                     // Get audio device callback counters
+RLAPI void ResetAudioDeviceStats(void);                               // Reset audio device callback counters
+
 RLAPI void AttachAudioStreamProcessor(AudioStream stream, AudioCallback processor); // Attach audio stream processor to stream, receives the samples as <float>s
 RLAPI void DetachAudioStreamProcessor(AudioStream stream, AudioCallback processor); // Detach audio stream processor from stream
 
@@ -384,6 +384,17 @@ typedef struct rlRenderBatch {
     float currentDepth;         // Current depth value for next draw
 } rlRenderBatch;
 
+// Render submission counters, accumulated until rlResetRenderStats()
+// NOTE: Draw calls, batch flushes and vertices are counted when a batch is drawn,
+// texture and framebuffer switches when they are requested
+typedef struct rlRenderStats {
+    unsigned int drawCalls;             // glDrawArrays()/glDrawElements() calls issued by render batches
+    unsigned int batchFlushes;          // Render batches drawn with some vertex data
+    unsigned int textureSwitches;       // Batch texture changes, every one starts a new draw call
+    unsigned int vertexCount;           // Vertices uploaded by render batches, including alignment
+    unsigned int framebufferSwitches;   // Framebuffer (render texture) binds
+} rlRenderStats;
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -680,6 +691,9 @@ RLAPI bool rlCheckRenderBatchLimit(int vCount);                             // C
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
+RLAPI rlRenderStats rlGetRenderStats(void);             // Get render submission counters
+RLAPI void rlResetRenderStats(void);                    // Reset render submission counters
+
 //------------------------------------------------------------------------------------------------------------------------
 
 // Vertex buffers management
@@ -1046,6 +1060,8 @@ typedef void *(*rlglLoadProc)(const char *name);   // OpenGL extension functions
 static rlglData RLGL = { 0 };
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
+static rlRenderStats RLGL_STATS = { 0 };    // Render submission counters
+
 #if defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_ES3)
 // NOTE: VAO functionality is exposed through extensions (OES)
 static PFNGLGENVERTEXARRAYSOESPROC glGenVertexArrays = NULL;
@@ -1527,6 +1543,8 @@ void rlSetTexture(unsigned int id)
 #else
         if (RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId != id)
         {
+            RLGL_STATS.textureSwitches++;
+
             if (RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount > 0)
             {
                 // Make sure current RLGL.currentBatch->draws[i].vertexCount is aligned a multiple of 4,
@@ -1710,6 +1728,7 @@ void rlEnableFramebuffer(unsigned int id)
 {
 #if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)) && defined(RLGL_RENDER_TEXTURES_HINT)
     glBindFramebuffer(GL_FRAMEBUFFER, id);
+    RLGL_STATS.framebufferSwitches++;
 #endif
 }
 
@@ -1718,6 +1737,7 @@ void rlDisableFramebuffer(void)
 {
 #if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)) && defined(RLGL_RENDER_TEXTURES_HINT)
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    RLGL_STATS.framebufferSwitches++;
 #endif
 }
 
@@ -2730,6 +2750,9 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
     // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (use a change detector flag?)
     if (RLGL.State.vertexCounter > 0)
     {
+        RLGL_STATS.batchFlushes++;
+        RLGL_STATS.vertexCount += RLGL.State.vertexCounter;
+
         // Activate elements VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
 
@@ -2867,6 +2890,8 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
                 vertexOffset += (batch->draws[i].vertexCount + batch->draws[i].vertexAlignment);
             }
 
+            RLGL_STATS.drawCalls += batch->drawCounter;
+
             if (!RLGL.ExtSupported.vao)
             {
                 glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -2918,6 +2943,19 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
 #endif
 }
 
+// Get render submission counters
+rlRenderStats rlGetRenderStats(void)
+{
+    return RLGL_STATS;
+}
+
+// Reset render submission counters
+void rlResetRenderStats(void)
+{
+    rlRenderStats stats = { 0 };
+    RLGL_STATS = stats;
+}
+
 // Set the active render batch for rlgl
 void rlSetRenderBatchActive(rlRenderBatch *batch)
 {
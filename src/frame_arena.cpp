@@ -0,0 +1,58 @@
+#include "frame_arena.hpp"
+
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+#include <raylib.h>
+
+FrameArena::FrameArena(size_t capacity)
+  : capacity(capacity), buffer(std::make_unique<std::byte[]>(capacity)),
+    resource(buffer.get(), capacity, std::pmr::new_delete_resource())
+{
+}
+
+void FrameArena::reset() noexcept
+{
+  // NOTE: Releasing a monotonic resource frees the heap blocks it overflowed to and rewinds the initial buffer
+  resource.release();
+  used       = 0;
+  overflowed = false;
+}
+
+void *FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+  void *ptr = resource.allocate(bytes, alignment);
+
+  used += bytes;
+  high_water_mark = std::max(high_water_mark, used);
+  if (!overflowed && used > capacity)
+  {
+    overflowed = true;
+    overflow_count++;
+  }
+
+  return ptr;
+}
+
+void FrameArena::draw_debug() const noexcept
+{
+  const int font_size = 10;
+  const int y         = GetScreenHeight() - 5 * (font_size + 2) - 10;
+
+  DrawText(TextFormat("Frame arena: %zu bytes, peak %zu of %zu, %llu overflows",
+                      used,
+                      high_water_mark,
+                      capacity,
+                      static_cast<unsigned long long>(overflow_count)),
+           40,
+           y,
+           font_size,
+           overflow_count > 0 ? RED : GOLD);
+}
+
+nlohmann::json FrameArena::to_json() const
+{
+  return nlohmann::json{ { "capacity", capacity },
+                         { "high_water_mark", high_water_mark },
+                         { "overflow_count", overflow_count } };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include <nlohmann/json_fwd.hpp>
+
+// NOTE: Bump allocator for data that lives within one tick or one draw, use it as the memory resource of
+//       std::pmr containers and strings. Deallocation is a no-op, everything is released at once by reset()
+//       at the start of Game::update, so nothing allocated from it may be kept across a frame. When the
+//       block is full the arena falls back to the heap until the next reset, the high water mark tells how
+//       large the block has to be.
+class FrameArena final : public std::pmr::memory_resource
+{
+public:
+  static constexpr const size_t DEFAULT_CAPACITY{ 64 * 1024 };
+
+  explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+
+  FrameArena(const FrameArena &)            = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  void reset() noexcept;
+
+  [[nodiscard]] size_t get_capacity() const noexcept { return capacity; }
+  [[nodiscard]] size_t get_used() const noexcept { return used; }
+  [[nodiscard]] size_t get_high_water_mark() const noexcept { return high_water_mark; }
+  // frames that needed more than the capacity
+  [[nodiscard]] uint64_t get_overflow_count() const noexcept { return overflow_count; }
+
+  void draw_debug() const noexcept;
+  [[nodiscard]] nlohmann::json to_json() const;
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void *, size_t, size_t) noexcept override {}
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  size_t capacity{ 0 };
+  std::unique_ptr<std::byte[]> buffer;
+  std::pmr::monotonic_buffer_resource resource;
+  size_t used{ 0 };
+  size_t high_water_mark{ 0 };
+  uint64_t overflow_count{ 0 };
+  bool overflowed{ false };
+};
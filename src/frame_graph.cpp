@@ -0,0 +1,96 @@
+#include "frame_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "profiler.hpp"
+
+FrameGraph::FrameGraph(int width, int height)
+  : width(width), height(height)
+{
+}
+
+void FrameGraph::add_pass(PassDescription &&description)
+{
+  assert(description.render);
+  assert(find_pass(description.name) == passes.size());
+
+  Pass pass;
+  for (const auto &input : description.inputs)
+  {
+    // NOTE: Inputs have to be declared first, so declaration order is a valid execution order
+    const size_t input_index = find_pass(input);
+    assert(input_index < passes.size());
+    pass.inputs.push_back(input_index);
+  }
+
+  pass.render_pass              = std::make_unique<RenderPass>(width, height);
+  pass.render_pass->render_func = description.render;
+  pass.description              = std::move(description);
+
+  TraceLog(LOG_TRACE, "FrameGraph: adding pass \"%s\"", pass.description.name.c_str());
+  passes.push_back(std::move(pass));
+}
+
+void FrameGraph::render(Profiler &profiler)
+{
+  for (auto &pass : passes)
+  {
+    const bool input_rendered =
+      std::any_of(pass.inputs.begin(), pass.inputs.end(), [this](size_t input) { return passes[input].rendered; });
+
+    pass.rendered = !pass.is_valid || input_rendered || !pass.description.is_dirty || pass.description.is_dirty();
+    if (!pass.rendered)
+    {
+      pass.skip_count++;
+      continue;
+    }
+
+    const auto section = profiler.scope(pass.description.name.c_str());
+    pass.render_pass->render();
+    pass.is_valid = true;
+    pass.render_count++;
+  }
+}
+
+void FrameGraph::draw(const Rectangle &render_destination)
+{
+  for (auto &pass : passes)
+  {
+    if (pass.description.composite)
+      pass.render_pass->draw(render_destination);
+  }
+}
+
+const Texture2D &FrameGraph::get_output(const std::string &name) const
+{
+  const size_t index = find_pass(name);
+  assert(index < passes.size());
+  return passes[index].render_pass->render_texture.texture;
+}
+
+size_t FrameGraph::find_pass(const std::string &name) const
+{
+  const auto it =
+    std::find_if(passes.begin(), passes.end(), [&name](const Pass &pass) { return pass.description.name == name; });
+  return static_cast<size_t>(std::distance(passes.begin(), it));
+}
+
+void FrameGraph::draw_debug() const noexcept
+{
+  const int font_size = 10;
+  int y               = 20;
+
+  for (const auto &pass : passes)
+  {
+    DrawText(TextFormat("%-8s rendered: %llu skipped: %llu",
+                        pass.description.name.c_str(),
+                        static_cast<unsigned long long>(pass.render_count),
+                        static_cast<unsigned long long>(pass.skip_count)),
+             260,
+             y,
+             font_size,
+             GOLD);
+    y += font_size + 2;
+  }
+}
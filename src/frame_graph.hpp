@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <raylib.h>
+
+#include "render_pass.hpp"
+
+class Profiler;
+
+// NOTE: Render passes declared in dependency order. A pass is rendered again only when its dirty predicate
+//       says so or when one of its inputs was rendered this frame, otherwise its render texture is reused.
+class FrameGraph
+{
+public:
+  struct PassDescription
+  {
+    std::string name;
+    std::vector<std::string> inputs; // passes whose output is read by render
+    std::function<bool()> is_dirty;  // when empty, the pass is rendered every frame
+    std::function<void()> render;
+    bool composite{ true }; // drawn to the screen by draw()
+  };
+
+  FrameGraph(int width, int height);
+
+  void add_pass(PassDescription &&description);
+
+  // renders the dirty passes into their render textures, each one in a profiler section named after it
+  void render(Profiler &profiler);
+  // draws the composited passes in declaration order
+  void draw(const Rectangle &render_destination);
+
+  [[nodiscard]] const Texture2D &get_output(const std::string &name) const;
+
+  void draw_debug() const noexcept;
+
+private:
+  struct Pass
+  {
+    PassDescription description;
+    std::vector<size_t> inputs;
+    std::unique_ptr<RenderPass> render_pass;
+    bool is_valid{ false };
+    bool rendered{ false };
+    uint64_t render_count{ 0 };
+    uint64_t skip_count{ 0 };
+  };
+
+  [[nodiscard]] size_t find_pass(const std::string &name) const;
+
+  int width{ 0 };
+  int height{ 0 };
+  std::vector<Pass> passes;
+};
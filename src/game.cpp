@@ -1,19 +1,32 @@
 #include "game.hpp"
 
+#include <algorithm>
 #include <cassert>
 
+#include <nlohmann/json.hpp>
 #include <raylib.h>
 #include <raymath.h>
 
 #include "asteroid.hpp"
+#include "audio_monitor.hpp"
+#include "background_layers.hpp"
 #include "bullet.hpp"
+#include "emitter.hpp"
+#include "frame_arena.hpp"
 #include "interactable.hpp"
 #include "object_circular_buffer.hpp"
 #include "particle.hpp"
 #include "pickable.hpp"
 #include "player_character.hpp"
 #include "player_ship.hpp"
+#include "profiler.hpp"
+#include "quality_governor.hpp"
+#include "render_queue.hpp"
 #include "room.hpp"
+#include "scheduler.hpp"
+#include "software_framebuffer.hpp"
+#include "targeting.hpp"
+#include "timing_wheel.hpp"
 #include "utils.hpp"
 
 void MissionParameters::unlock() noexcept
@@ -24,6 +37,7 @@ void MissionParameters::unlock() noexcept
   Quest::sound_complete.play();
 
   unlocked = true;
+  GAME.event_bus.publish(GameEvent{ .type = GameEvent::Type::MissionUnlocked, .value = number });
 
   if (!name.starts_with('_'))
     GAME.gui->show_message("Mission unlocked: " + name);
@@ -40,16 +54,36 @@ Game &Game::get() noexcept
 
 void Game::init()
 {
+  // NOTE: Before anything loads these sounds
+  SoundManager::configure("resources/explosion_asteroid1.qoa", 3, SoundManager::Priority::Low);
+  SoundManager::configure("resources/explosion_asteroid2.qoa", 3, SoundManager::Priority::Low);
+  SoundManager::configure("resources/explosion_asteroid3.qoa", 3, SoundManager::Priority::Low);
+  SoundManager::configure("resources/shoot.qoa", 4, SoundManager::Priority::Normal);
+  SoundManager::configure("resources/pickup.qoa", 3, SoundManager::Priority::Normal);
+  SoundManager::configure("resources/step.qoa", 1, SoundManager::Priority::Normal);
+  SoundManager::configure("resources/engine.qoa", 1, SoundManager::Priority::High);
+  SoundManager::configure("resources/explosion.qoa", 1, SoundManager::Priority::High);
+  SoundManager::configure("resources/warp.qoa", 1, SoundManager::Priority::High);
+  SoundManager::configure("resources/tada.qoa", 1, SoundManager::Priority::High);
+  SoundManager::configure("resources/select.qoa", 2, SoundManager::Priority::High);
+  SoundManager::configure("resources/accept.qoa", 1, SoundManager::Priority::High);
+
   gui = std::make_unique<GUI>();
 
   asteroid_bg_sprite = std::make_unique<Sprite>("resources/asteroid.aseprite");
 
-  station_music.push_back(LoadMusicStream("resources/music/galactic-cafe-ambient-loop.mp3"));
-  station_music.push_back(LoadMusicStream("resources/music/space-elevator-background-loop.mp3"));
+  audio = std::make_unique<AudioMonitor>(config.adaptive_audio_buffer);
+  music = std::make_unique<MusicPlayer>(audio->get_buffer_frames());
+
+  station_music.add(music->load("resources/music/galactic-cafe-ambient-loop.mp3"));
+  station_music.add(music->load("resources/music/space-elevator-background-loop.mp3"));
+
+  asteroid_music.add(music->load("resources/music/ambient-pop.mp3"));
+  asteroid_music.add(music->load("resources/music/ocean-space-ambient.mp3"));
+  asteroid_music.add(music->load("resources/music/electric-chill-pop.mp3"));
 
-  asteroid_music.push_back(LoadMusicStream("resources/music/ambient-pop.mp3"));
-  asteroid_music.push_back(LoadMusicStream("resources/music/ocean-space-ambient.mp3"));
-  asteroid_music.push_back(LoadMusicStream("resources/music/electric-chill-pop.mp3"));
+  music->set_volume(music_volume);
+  music->start();
 
   missions = { { 0, { .name = "_tutorial", .description = "Ship tutorial", .number_of_asteroids = 3 } },
                { 1,
@@ -115,6 +149,8 @@ void Game::init()
 
                  } },
                { 10, { .name = "_the_end", .description = "The End", .number_of_asteroids = 0 } } };
+  for (auto &[number, mission] : missions)
+    mission.number = number;
 
   Room::load();
   room = Room::get(Room::Type::DockingBay);
@@ -124,10 +160,35 @@ void Game::init()
   camera.zoom     = 1.0f;
   camera.rotation = 0.0f;
 
+  bullets            = std::make_unique<ObjectCircularBuffer<Bullet, 64>>();
+  asteroids          = std::make_unique<AsteroidPools>();
+  particles          = std::make_unique<ObjectCircularBuffer<Particle, 4096>>();
+  pickables          = std::make_unique<ObjectCircularBuffer<Pickable, 512>>();
+  targets            = std::make_unique<TargetIndex>();
+  scheduler          = std::make_unique<Scheduler>();
+  events             = std::make_unique<TimingWheel>();
+  quality            = std::make_unique<QualityGovernor>();
+  profiler           = std::make_unique<Profiler>();
+  frame_arena        = std::make_unique<FrameArena>();
+  profiler->add_export("audio", [this] { return audio->to_json(); });
+  profiler->add_export("frame_arena", [this] { return frame_arena->to_json(); });
+  // NOTE: Hot paths that are expected to stay allocation free, only checked with TRACK_ALLOCATIONS
+  profiler->set_allocation_budget("update/bullets", 0, Profiler::BudgetAction::Log);
+  profiler->set_allocation_budget("update/asteroids", 0, Profiler::BudgetAction::Log);
+  profiler->set_allocation_budget("update/particles", 0, Profiler::BudgetAction::Log);
+  star_layer         = std::make_unique<SoftwareFramebuffer>(width, height);
+  particle_layer     = std::make_unique<SoftwareFramebuffer>(width, height);
+  render_queue       = std::make_unique<RenderQueue>();
+  background_layers  = std::make_unique<BackgroundLayers>(width, height, *asteroid_bg_sprite);
+  prepared.bullets   = std::make_unique<ObjectCircularBuffer<Bullet, 64>>();
+  prepared.asteroids = std::make_unique<AsteroidPools>();
+  prepared.particles = std::make_unique<ObjectCircularBuffer<Particle, 4096>>();
+  prepared.pickables = std::make_unique<ObjectCircularBuffer<Pickable, 512>>();
+
   set_mission(0);
   set_state(GameState::PLAYING_ASTEROIDS);
 
-  TraceLog(LOG_TRACE, "Size of Asteroid buffer: %zukB", sizeof(Asteroid) * asteroids->capacity / 1024);
+  TraceLog(LOG_TRACE, "Size of Asteroid buffers: %zukB", sizeof(AsteroidPools) / 1024);
   TraceLog(LOG_TRACE, "Size of Bullet buffer: %zukB", sizeof(Bullet) * bullets->capacity / 1024);
   TraceLog(LOG_TRACE, "Size of Particle buffer: %zukB", sizeof(Particle) * particles->capacity / 1024);
   TraceLog(LOG_TRACE, "Size of Pickable buffer: %zukB", sizeof(Pickable) * pickables->capacity / 1024);
@@ -135,48 +196,65 @@ void Game::init()
   for (size_t i = 0; i < stars.size(); i++)
     stars[i] = Vector2{ static_cast<float>(GetRandomValue(0, width)), static_cast<float>(GetRandomValue(0, height)) };
 
+  event_bus.clear();
   quests.clear();
+  Quest::revision++; // NOTE: the HUD lays out its quest lines again
   quests.emplace("captain1",
                  Quest{ .description  = "Collect 10 crystals",
-                        .progress     = []() { return GAME.crystals; },
-                        .max_progress = []() { return 10; },
+                        .event        = GameEvent::Type::CrystalsChanged,
+                        .advance      = [](const GameEvent &event, size_t) { return event.value; },
+                        .max_progress = 10,
                         .on_report =
                           []()
                         {
-                          GAME.crystals -= 10;
+                          GAME.spend_crystals(10);
                           MISSION(3).unlock();
                         } });
 
   quests.emplace("meet_captain",
                  Quest{ .description  = "Meet the captain",
-                        .progress     = []() { return Dialog::is_introduced("Captain"); },
-                        .max_progress = []() { return true; },
+                        .event        = GameEvent::Type::CharacterIntroduced,
+                        .advance      = [](const GameEvent &event, size_t progress)
+                        { return event.name == "Captain" ? 1 : progress; },
+                        .max_progress = 1,
                         .on_report    = []() { GAME.score += 1000; } });
 
   quests.emplace("tutorial",
                  Quest{ .description  = "Destroy all asteroids",
-                        .progress     = []() { return static_cast<int>(GAME.asteroids->empty()); },
-                        .max_progress = []() { return 1; },
+                        .event        = GameEvent::Type::AsteroidsCleared,
+                        .advance      = [](const GameEvent &, size_t) { return 1; },
+                        .max_progress = 1,
                         .on_report    = []() { GAME.score += 2000; } });
 
   quests.emplace("scientist1",
                  Quest{ .description  = "Find an alien artifact",
-                        .progress     = []() { return GAME.artifacts.size(); },
-                        .max_progress = []() { return 1; },
+                        .event        = GameEvent::Type::ArtifactFound,
+                        .advance      = [](const GameEvent &event, size_t) { return event.value; },
+                        .max_progress = 1,
                         .on_report    = []() { GAME.score += 1000; } });
 
   quests.emplace("meet_captain2",
                  Quest{ .description  = "Talk to the captain",
-                        .progress     = []() { return MISSION(6).is_unlocked(); },
-                        .max_progress = []() { return true; },
+                        .event        = GameEvent::Type::MissionUnlocked,
+                        .advance      = [](const GameEvent &event, size_t progress)
+                        { return event.value == 6 ? 1 : progress; },
+                        .max_progress = 1,
                         .on_report    = []() { GAME.score += 1000; } });
 
   quests.emplace("all_missions",
                  Quest{ .description  = "Complete all missions",
-                        .progress     = []() { return MISSION(10).is_unlocked(); },
-                        .max_progress = []() { return true; },
+                        .event        = GameEvent::Type::MissionUnlocked,
+                        .advance      = [](const GameEvent &event, size_t progress)
+                        { return event.value == 10 ? 1 : progress; },
+                        .max_progress = 1,
                         .on_report    = []() { GAME.score += 90000; } });
 
+  // NOTE: Map nodes do not move, the handlers keep pointing at their quest until the quests are cleared
+  for (auto &[quest_name, quest] : quests)
+    event_bus.subscribe(quest.event, [&quest](const GameEvent &event) { quest.on_event(event); });
+
+  add_scheduler_jobs();
+
   gui->show_message("Welcome to the \"Space Something\" game!");
   gui->show_message("Click on the screen to focus the game");
 
@@ -193,26 +271,30 @@ void Game::unload() noexcept
   asteroids.reset();
   particles.reset();
   pickables.reset();
+  targets.reset();
+  scheduler.reset();
+  events.reset();
+  quality.reset();
+  profiler.reset();
+  frame_arena.reset();
+  star_layer.reset();
+  particle_layer.reset();
+  render_queue.reset();
+  background_layers.reset();
   asteroid_bg_sprite.reset();
+  prepared = PreparedState{};
   quests.clear();
-  actions   = std::queue<Action>{};
+  event_bus.clear();
+  actions   = std::queue<std::variant<Action, Script>>{};
   artifacts = std::queue<Artifact>{};
   Pickable::ORE_SPRITE.reset();
   Asteroid::ASTEROID_SPRITE.reset();
 
-  for (auto &music : station_music)
-  {
-    StopMusicStream(music);
-    UnloadMusicStream(music);
-  }
+  // NOTE: Joins the audio thread before the streams are unloaded
+  music.reset();
   station_music.clear();
-
-  for (auto &music : asteroid_music)
-  {
-    StopMusicStream(music);
-    UnloadMusicStream(music);
-  }
   asteroid_music.clear();
+  audio.reset();
 }
 
 Game::~Game() noexcept
@@ -223,13 +305,24 @@ Game::~Game() noexcept
 
 void Game::update()
 {
-  if (IsMusicReady(current_music) && IsMusicStreamPlaying(current_music))
-    UpdateMusicStream(current_music);
+  frame_arena->reset();
+
+  // NOTE: Baked here and not in draw, raylib cannot begin a texture mode inside the one of a frame graph pass
+  background_layers->bake(static_cast<int>(quality->settings().background_density * 100.0f));
+
+  music->update();
 
   if (!actions.empty())
   {
+    bool is_done{ false };
+    if (Script *script = std::get_if<Script>(&actions.front()); script)
+    {
+      script->update();
+      is_done = script->is_done();
+    }
+    else
     {
-      Action &action = actions.front();
+      Action &action = std::get<Action>(actions.front());
 
       if (!action.has_started)
       {
@@ -240,9 +333,10 @@ void Game::update()
       action.update();
       if (action.is_done)
         action.done();
+      is_done = action.is_done;
     }
 
-    if (actions.front().is_done)
+    if (is_done)
     {
       actions.pop();
       return;
@@ -252,13 +346,7 @@ void Game::update()
   update_game();
 
   if (gui)
-  {
-    for (auto &message : gui->messages)
-      message.timer.update();
-
-    while (!gui->messages.empty() && gui->messages.front().timer.is_done())
-      gui->messages.pop_front();
-  }
+    gui->update();
 
   if (input.mute_pressed())
   {
@@ -281,7 +369,7 @@ void Game::update()
       SoundManager::volume  = 0.0f;
     }
 
-    SetMusicVolume(current_music, music_volume);
+    music->set_volume(music_volume);
   }
 
   frame++;
@@ -291,24 +379,54 @@ void Game::update_game()
 {
   assert(room);
 
+  const QualitySettings &quality_settings = quality->settings();
+  scheduler->set_period(particle_forces_job, quality_settings.particle_forces_period);
+  scheduler->update(GetFrameTime());
+
   if (!gui->is_active())
   {
-    for (auto &interactable : room->interactables)
-      interactable->update();
+    world_revision++;
+    // NOTE: Timed events are part of the simulation, they wait while the entities are frozen
+    if (!freeze_entities)
+      events->advance();
+
+    {
+      const auto section = profiler->scope("interactables");
+      for (auto &interactable : room->interactables)
+        interactable->update();
+    }
 
     if (state == GameState::PLAYING_ASTEROIDS)
     {
       if (!freeze_entities)
       {
-        player->update();
-        bullets->for_each(std::bind(&Bullet::update, std::placeholders::_1));
-        asteroids->for_each(std::bind(&Asteroid::update, std::placeholders::_1));
-        pickables->for_each(std::bind(&Pickable::update, std::placeholders::_1));
+        {
+          const auto section = profiler->scope("targets");
+          targets->build(*asteroids);
+        }
+        {
+          const auto section = profiler->scope("player");
+          player->update();
+        }
+        {
+          const auto section = profiler->scope("bullets");
+          bullets->for_each(std::bind(&Bullet::update, std::placeholders::_1));
+        }
+        {
+          const auto section = profiler->scope("asteroids");
+          asteroids->update();
+        }
+        {
+          const auto section = profiler->scope("pickables");
+          pickables->for_each(std::bind(&Pickable::update, std::placeholders::_1));
+        }
       }
 
-      particles->for_each(std::bind(&Particle::update, std::placeholders::_1));
-
-      update_background();
+      {
+        const auto section = profiler->scope("particles");
+        particles->for_each([decay = quality_settings.particle_alpha_decay](Particle &particle)
+                            { return particle.update(decay); });
+      }
 
       const auto &mission = missions[current_mission];
       if (survive_time > 0.0f)
@@ -321,7 +439,7 @@ void Game::update_game()
           if (Vector2Distance(position, player->position) < 120.0f)
             return;
 
-          asteroids->push(Asteroid::create_normal(position, 2));
+          asteroids->rocks.push(Asteroid::create_normal(position, 2));
         }
       }
       if (mission.survive_time_seconds > 0.0f && survive_time <= 0.0f)
@@ -369,7 +487,7 @@ void Game::update_game()
       {
         const Vector2 position = { static_cast<float>(GetRandomValue(0, width)),
                                    static_cast<float>(GetRandomValue(0, height)) };
-        asteroids->push(Asteroid::create_normal(position, 2));
+        asteroids->rocks.push(Asteroid::create_normal(position, 2));
       }
     }
 
@@ -394,6 +512,12 @@ void Game::update_game()
       CONFIG(show_masks) = !CONFIG(show_masks);
     }
 
+    // NOTE: Quality, scheduler, frame graph, profiler, audio and frame arena overlays
+    if (IsKeyPressed(KEY_F8))
+    {
+      CONFIG(show_debug) = !CONFIG(show_debug);
+    }
+
     if (IsKeyPressed(KEY_F5))
     {
       static int room = 0;
@@ -404,7 +528,7 @@ void Game::update_game()
     if (IsKeyPressed(KEY_F6))
     {
       const int N = 10;
-      crystals += N;
+      add_crystals(N);
       gui->show_message(std::to_string(N) + " crystals added");
     }
     if (IsKeyPressed(KEY_F7))
@@ -412,17 +536,33 @@ void Game::update_game()
       for (auto &[id, mission] : missions)
         mission.unlock();
     }
+
+    if (IsKeyPressed(KEY_F9))
+    {
+      profiler->write_json("profile.json");
+    }
+
+    if (IsKeyPressed(KEY_F10))
+    {
+      profiler->set_flush_sections(!profiler->get_flush_sections());
+    }
   }
 #endif
 }
 
-void Game::update_background() noexcept
+// NOTE: Stars are moved by the scheduler, each one once every STARS_UPDATE_PERIOD ticks
+static constexpr const uint32_t STARS_UPDATE_PERIOD{ 2 };
+
+void Game::update_background(size_t first_star, size_t last_star) noexcept
 {
-  for (size_t i = 0; i < stars.size(); i++)
+  const float step = static_cast<float>(STARS_UPDATE_PERIOD);
+  last_star        = std::min(last_star, stars.size());
+  stars_dirty      = stars_dirty || first_star < last_star;
+  for (size_t i = first_star; i < last_star; i++)
   {
-    stars[i].x += 0.1f;
+    stars[i].x += 0.1f * step;
     if (i % 2 == 0)
-      stars[i].x += 0.2f;
+      stars[i].x += 0.2f * step;
 
     if (stars[i].x > width)
     {
@@ -432,42 +572,129 @@ void Game::update_background() noexcept
   }
 }
 
+void Game::add_scheduler_jobs()
+{
+  const auto is_simulating_asteroids = [this]()
+  { return state == GameState::PLAYING_ASTEROIDS && gui && !gui->is_active(); };
+
+  particle_forces_job = scheduler->add_job(
+    { .name         = "particle_forces",
+      .period_ticks = quality->settings().particle_forces_period,
+      .budget_us    = 500.0f,
+      .chunk_size   = 256,
+      .work_size    = [this, is_simulating_asteroids]() { return is_simulating_asteroids() ? particles->size() : 0; },
+      .run          = [this](size_t begin, size_t end)
+      { particles->for_each_in(begin, end, [](Particle &particle) { particle.apply_asteroid_forces(); }); } });
+
+  scheduler->add_job({ .name         = "background",
+                       .period_ticks = STARS_UPDATE_PERIOD,
+                       .budget_us    = 100.0f,
+                       .chunk_size   = 25,
+                       .work_size    = [this, is_simulating_asteroids]()
+                       { return is_simulating_asteroids() ? stars.size() : 0; },
+                       .run          = [this](size_t begin, size_t end) { update_background(begin, end); } });
+}
+
 void Game::draw() noexcept
 {
+  drawn_view = get_view_rect();
   BeginMode2D(camera);
 
-  draw_background();
+  {
+    const auto section = profiler->scope("background");
+    draw_background();
+  }
 
   assert(room);
   assert(room->background_tiles.empty() || !room->tileset_name.empty());
   assert(room->foreground_tiles.empty() || !room->tileset_name.empty());
 
-  for (const auto &tile : room->background_tiles)
-    DrawTextureRec(tileset_sprite->get_texture(), tile.source, tile.position, WHITE);
+  // NOTE: Only the tile chunks and interactables overlapping the view are drawn, so room size does not matter
+  const Rectangle &view = drawn_view;
+  auto draw_tile        = [this](const Tile &tile)
+  { DrawTextureRec(tileset_sprite->get_texture(), tile.source, tile.position, WHITE); };
+
+  {
+    const auto section = profiler->scope("tiles");
+    room->background_tiles.for_each_visible(view, draw_tile);
+  }
+
+  // NOTE: Particles are rasterised on the CPU and drawn as a single texture covering the view
+  const Vector2 view_origin = Vector2Subtract(camera.target, camera.offset);
+  {
+    const auto section = profiler->scope("particles");
+    particle_layer->clear();
+    particles->for_each([&](const Particle &particle) { particle.draw(*particle_layer, view_origin); });
+  }
 
+  // NOTE: Sections entered twice because of the fallthrough are accumulated by the profiler
   switch (state)
   {
     case GameState::PLAYING_ASTEROIDS:
     {
-      for (const auto &interactable : room->interactables)
-        interactable->draw();
+      {
+        const auto section = profiler->scope("interactables");
+        for (const auto &interactable : room->interactables)
+        {
+          if (CheckCollisionRecs(interactable->get_bounds(), view))
+            interactable->draw();
+        }
+      }
+
+      {
+        const auto section = profiler->scope("particles");
+        particle_layer->draw(view_origin);
+      }
+
+      {
+        const auto section = profiler->scope("bullets");
+        bullets->for_each([&](const Bullet &bullet) { bullet.draw(*render_queue); });
+        render_queue->submit();
+      }
 
-      particles->for_each(std::bind(&Particle::draw, std::placeholders::_1));
+      {
+        const auto section = profiler->scope("player");
+        player->draw();
+      }
+
+      {
+        const auto section = profiler->scope("asteroids");
+        asteroids->draw(*render_queue);
+        render_queue->submit();
+      }
 
-      bullets->for_each(std::bind(&Bullet::draw, std::placeholders::_1));
-      player->draw();
-      asteroids->for_each(std::bind(&Asteroid::draw, std::placeholders::_1));
-      pickables->for_each(std::bind(&Pickable::draw, std::placeholders::_1));
+      {
+        const auto section = profiler->scope("pickables");
+        pickables->for_each([&](const Pickable &pickable) { pickable.draw(*render_queue); });
+        render_queue->submit();
+      }
     }
     case GameState::PLAYING_STATION:
     {
-      for (const auto &interactable : room->interactables)
-        interactable->draw();
+      {
+        const auto section = profiler->scope("interactables");
+        for (const auto &interactable : room->interactables)
+        {
+          if (CheckCollisionRecs(interactable->get_bounds(), view))
+            interactable->draw();
+        }
+      }
+
+      {
+        const auto section = profiler->scope("particles");
+        particle_layer->draw(view_origin);
+      }
 
-      particles->for_each(std::bind(&Particle::draw, std::placeholders::_1));
-      pickables->for_each(std::bind(&Pickable::draw, std::placeholders::_1));
+      {
+        const auto section = profiler->scope("pickables");
+        pickables->for_each([&](const Pickable &pickable) { pickable.draw(*render_queue); });
+        render_queue->submit();
+      }
 
-      player->draw();
+      {
+        const auto section = profiler->scope("player");
+        player->draw();
+      }
 
       if (CONFIG(show_masks))
       {
@@ -475,7 +702,9 @@ void Game::draw() noexcept
           mask.draw();
 
         for (const auto &interactable : room->interactables)
-          Mask(interactable->get_sprite().get_destination_rect()).draw();
+          Mask::draw_shape(Vector2{},
+                           interactable->get_sprite().get_destination_rect(),
+                           Mask::debug_color(interactable.get()));
       }
     }
     case GameState::GAME_OVER:
@@ -484,141 +713,230 @@ void Game::draw() noexcept
       break;
   }
 
-  for (const auto &tile : room->foreground_tiles)
-    DrawTextureRec(tileset_sprite->get_texture(), tile.source, tile.position, WHITE);
+  {
+    const auto section = profiler->scope("tiles");
+    room->foreground_tiles.for_each_visible(view, draw_tile);
+  }
 
   EndMode2D();
+}
+
+Rectangle Game::get_view_rect() const noexcept
+{
+  const Vector2 size{ static_cast<float>(width) / camera.zoom, static_cast<float>(height) / camera.zoom };
+  const Vector2 origin = GetScreenToWorld2D(Vector2Zero(), camera);
+  return Rectangle{ origin.x, origin.y, size.x, size.y };
+}
 
+void Game::draw_actions() const noexcept
+{
   if (!actions.empty())
   {
-    const Action &action = actions.front();
-    action.draw();
+    if (const Script *script = std::get_if<Script>(&actions.front()); script)
+      script->draw();
+    else
+      std::get<Action>(actions.front()).draw();
   }
 }
 
 void Game::draw_background() noexcept
 {
-  for (size_t i = 0; i < stars.size(); i++)
+  // NOTE: Stars only move when the background job runs, the layer is not rasterised nor uploaded otherwise
+  if (stars_dirty)
   {
-    const Vector2 &star = stars[i];
-    if (i % 2 == 0)
-      DrawPixel(star.x, star.y, Color{ 240, 180, 100, 255 });
-    else
-      DrawPixel(star.x, star.y, Color{ 120, 230, 100, 255 });
+    star_layer->clear();
+    for (size_t i = 0; i < stars.size(); i++)
+    {
+      const Vector2 &star = stars[i];
+      const int x         = static_cast<int>(star.x);
+      const int y         = static_cast<int>(star.y);
+      if (i % 2 == 0)
+        star_layer->blend_pixel(x, y, Color{ 240, 180, 100, 255 });
+      else
+        star_layer->blend_pixel(x, y, Color{ 120, 230, 100, 255 });
+    }
+    stars_dirty = false;
   }
+  star_layer->draw(Vector2Zero());
+
+  background_layers->draw(world_revision);
+}
 
-  asteroid_bg_sprite->set_frame(1);
-  asteroid_bg_sprite->tint = ColorBrightness(BLACK, 0.2f);
-  const long &w            = static_cast<long>(asteroid_bg_sprite->get_width());
-  const long &h            = static_cast<long>(asteroid_bg_sprite->get_height());
+void Game::set_state(GameState new_state) noexcept
+{
+  prepare_state(new_state, current_mission);
+  swap_prepared_state();
+}
 
-  for (int x = -w; x <= width + w; x += asteroid_bg_sprite->get_width())
+void Game::prepare_state(GameState new_state, size_t mission) noexcept
+{
+  assert(!missions.empty());
+  assert(mission < missions.size());
+  if (mission >= missions.size())
+    mission = missions.size() - 1;
+
+  prepared.state    = new_state;
+  prepared.mission  = mission;
+  prepared.spawned  = 0;
+  prepared.is_ready = false;
+  prepared.music.reset();
+  prepared.player.reset();
+  prepared.room.reset();
+
+  prepared.bullets->clear();
+  prepared.asteroids->clear();
+  prepared.particles->clear();
+  prepared.pickables->clear();
+
+  // NOTE: Prepared during the fade-out, so the track is opened and decoded by the time it plays
+  if (new_state == GameState::PLAYING_ASTEROIDS && !asteroid_music.empty())
   {
-    for (int y = -h; y <= height + h; y += asteroid_bg_sprite->get_height())
-    {
-      if ((x * y) % 3 == 0 || (x + y) % 5 == 0 || (x * y) % 7 == 0 || (x + y) % 9 == 0)
-        continue;
-
-      float xf = static_cast<float>(x) - sin(frame * 0.001f + x * 37.542f) * static_cast<float>(w) * 0.5f;
-      float yf = static_cast<float>(y) - cos(frame * 0.002f - y * 13.127f) * static_cast<float>(h) * 0.8f;
-      asteroid_bg_sprite->position = Vector2{ xf, yf };
-      asteroid_bg_sprite->set_frame((x + y - 1) % 3);
-      asteroid_bg_sprite->draw();
-    }
+    prepared.music = asteroid_music.take();
+    music->prefetch(*prepared.music);
   }
 }
 
-void Game::set_state(GameState new_state) noexcept
+bool Game::prepare_state_step(size_t budget) noexcept
 {
-  state = new_state;
+  if (prepared.is_ready)
+    return true;
 
-  bullets      = std::make_unique<ObjectCircularBuffer<Bullet, 64>>();
-  asteroids    = std::make_unique<ObjectCircularBuffer<Asteroid, 1024>>();
-  particles    = std::make_unique<ObjectCircularBuffer<Particle, 4096>>();
-  pickables    = std::make_unique<ObjectCircularBuffer<Pickable, 512>>();
-  survive_time = 0.0f;
+  const auto random_position = []()
+  { return Vector2{ static_cast<float>(GetRandomValue(0, width)), static_cast<float>(GetRandomValue(0, height)) }; };
 
-  switch (state)
+  switch (prepared.state)
   {
     case GameState::PLAYING_ASTEROIDS:
     {
-      current_music = asteroid_music[GetRandomValue(0, asteroid_music.size() - 1)];
-      PlayMusicStream(current_music);
-      SetMusicVolume(current_music, music_volume);
-
-      assert(!missions.empty());
-      assert(current_mission < missions.size());
-      if (current_mission >= missions.size())
-        current_mission = missions.size() - 1;
-
-      const auto &param = missions[current_mission];
-
-      player = std::make_unique<PlayerShip>();
-
-      for (size_t i = 0; i < param.number_of_asteroids; ++i)
-      {
-        const Vector2 position = { static_cast<float>(GetRandomValue(0, width)),
-                                   static_cast<float>(GetRandomValue(0, height)) };
-        asteroids->push(Asteroid::create_normal(position, 2));
-      }
+      const auto &param          = missions[prepared.mission];
+      const size_t asteroids_end = param.number_of_asteroids;
+      const size_t crystals_end  = asteroids_end + param.number_of_asteroid_crystals;
+      const size_t particles_end = crystals_end + prepared.mission * 3;
+      const size_t aliens_end    = particles_end + static_cast<size_t>(param.number_of_aliens);
 
-      for (size_t i = 0; i < param.number_of_asteroid_crystals; ++i)
+      for (; budget > 0 && prepared.spawned < aliens_end; --budget, ++prepared.spawned)
       {
-        const Vector2 position = { static_cast<float>(GetRandomValue(0, width)),
-                                   static_cast<float>(GetRandomValue(0, height)) };
-        asteroids->push(Asteroid::create_crystal(position));
+        const Vector2 position = random_position();
+
+        if (prepared.spawned < asteroids_end)
+          prepared.asteroids->rocks.push(Asteroid::create_normal(position, 2));
+        else if (prepared.spawned < crystals_end)
+          prepared.asteroids->crystals.push(Asteroid::create_crystal(position));
+        else if (prepared.spawned < particles_end)
+          ParticleEmitter::emit(*prepared.particles, Emitter::Ambient, position, 1);
+        else
+          prepared.asteroids->alien_ships.push(Asteroid::create_alien_ship(position));
       }
 
-      for (size_t i = 0; i < current_mission * 3; ++i)
-      {
-        Vector2 particle_position{ static_cast<float>(GetRandomValue(0, width)),
-                                   static_cast<float>(GetRandomValue(0, height)) };
-        Vector2 particle_velocity{ static_cast<float>(GetRandomValue(-100, 100)) / 100.0f,
-                                   static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
-        Color particle_color{ static_cast<unsigned char>(GetRandomValue(0, 255)),
-                              static_cast<unsigned char>(GetRandomValue(0, 255)),
-                              static_cast<unsigned char>(GetRandomValue(0, 255)),
-                              static_cast<unsigned char>(GetRandomValue(0, 255)) };
-        particles->push(Particle::create(particle_position, particle_velocity, particle_color));
-      }
+      if (prepared.spawned < aliens_end || budget == 0)
+        return false;
 
-      for (size_t i = 0; i < param.number_of_aliens; ++i)
-      {
-        const Vector2 position = { static_cast<float>(GetRandomValue(0, width)),
-                                   static_cast<float>(GetRandomValue(0, height)) };
-        asteroids->push(Asteroid::create_alien_ship(position));
-      }
+      prepared.player = std::make_unique<PlayerShip>();
 
-      room       = std::make_shared<Room>(); // NOTE: Asteroids room is not loaded from file
-      room->rect = Rectangle{ 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height) };
-      room->interactables.push_back(std::make_unique<Station>());
+      prepared.room       = std::make_shared<Room>(); // NOTE: Asteroids room is not loaded from file
+      prepared.room->rect = Rectangle{ 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height) };
+      prepared.room->interactables.push_back(std::make_unique<Station>());
 
-      if (current_mission == 0)
+      if (prepared.mission == 0)
       {
-        room->interactables.push_back(
+        prepared.room->interactables.push_back(
           std::make_unique<DialogEntity>(Vector2{ width * 10.0f, height * 10.0f }, "Navigator"));
-        DialogEntity *navigator = static_cast<DialogEntity *>(room->interactables.back().get());
-        schedule_action_conversation(*navigator);
       }
-
-      survive_time = param.survive_time_seconds;
-
       break;
     }
     case GameState::PLAYING_STATION:
       // Music is changed in specific room // current_music    = station_music[GetRandomValue(0, station_music.size() -
       // 1)];
-      player           = std::make_unique<PlayerCharacter>();
-      player->position = Vector2{ 200.0f, 90.0f };
+      prepared.player           = std::make_unique<PlayerCharacter>();
+      prepared.player->position = Vector2{ 200.0f, 90.0f };
       break;
     case GameState::GAME_OVER:
       break;
     default:
       break;
   }
+
+  prepared.is_ready = true;
+  return true;
+}
+
+void Game::swap_prepared_state() noexcept
+{
+  while (!prepare_state_step(std::numeric_limits<size_t>::max()))
+    ;
+
+  state           = prepared.state;
+  current_mission = prepared.mission;
+  world_revision++;
+
+  std::swap(bullets, prepared.bullets);
+  std::swap(asteroids, prepared.asteroids);
+  std::swap(particles, prepared.particles);
+  std::swap(pickables, prepared.pickables);
+  targets->clear();
+  events->clear();
+  prepared.bullets->clear();
+  prepared.asteroids->clear();
+  prepared.particles->clear();
+  prepared.pickables->clear();
+
+  if (prepared.player)
+    player = std::move(prepared.player);
+
+  if (prepared.room)
+    room = std::move(prepared.room);
+
+  survive_time = 0.0f;
+
+  if (state == GameState::PLAYING_ASTEROIDS)
+  {
+    if (prepared.music)
+      music->play(*prepared.music);
+    if (!station_music.empty())
+      music->prefetch(station_music.peek());
+
+    if (current_mission == 0)
+    {
+      for (auto &interactable : room->interactables)
+      {
+        if (DialogEntity *navigator = dynamic_cast<DialogEntity *>(interactable.get()); navigator)
+          schedule_action_conversation(*navigator);
+      }
+    }
+
+    survive_time = missions[current_mission].survive_time_seconds;
+
+    asteroids->schedule_events(*events);
+  }
+
+  // NOTE: The wheel was cleared, entities of the room re-arm their events once here instead of polling for it
+  for (auto &interactable : room->interactables)
+    interactable->schedule_events(*events);
+
+  prepared.music.reset();
+  prepared.is_ready = false;
 }
 
 void Game::set_mission(size_t mission) noexcept
 {
   current_mission = mission;
 }
+
+void Game::add_crystals(size_t count)
+{
+  crystals += count;
+  event_bus.publish(GameEvent{ .type = GameEvent::Type::CrystalsChanged, .value = crystals });
+}
+
+void Game::spend_crystals(size_t count)
+{
+  assert(count <= crystals);
+  crystals -= count;
+  event_bus.publish(GameEvent{ .type = GameEvent::Type::CrystalsChanged, .value = crystals });
+}
+
+void Game::add_artifact(Artifact &&artifact)
+{
+  artifacts.push(std::move(artifact));
+  event_bus.publish(GameEvent{ .type = GameEvent::Type::ArtifactFound, .value = artifacts.size() });
+}
@@ -14,10 +14,13 @@
 #include <raymath.h>
 
 #include "dialog.hpp"
+#include "event_bus.hpp"
 #include "gui.hpp"
 #include "input.hpp"
+#include "music_player.hpp"
 #include "quest.hpp"
 #include "room.hpp"
+#include "script.hpp"
 
 #define CONFIG(Option)       Game::config.Option
 #define GAME                 Game::get()
@@ -28,6 +31,17 @@ class Sprite;
 class Player;
 class Bullet;
 class Asteroid;
+struct AsteroidPools;
+class TargetIndex;
+class Scheduler;
+class TimingWheel;
+class QualityGovernor;
+class Profiler;
+class SoftwareFramebuffer;
+class RenderQueue;
+class BackgroundLayers;
+class AudioMonitor;
+class FrameArena;
 class Particle;
 class Pickable;
 class Interactable;
@@ -44,6 +58,7 @@ struct Config
   bool show_masks{ false };
   bool show_velocity{ false };
   bool debug_bullets{ false };
+  bool adaptive_audio_buffer{ true };
 };
 
 enum class GameState
@@ -125,6 +140,7 @@ struct MissionParameters
   [[nodiscard]] bool is_unlocked() const noexcept { return unlocked; }
 
   bool unlocked{ false };
+  size_t number{ 0 }; // key in Game::missions, set by Game::init
 };
 
 class Game
@@ -136,13 +152,21 @@ public:
   std::shared_ptr<Room> room;
   std::unique_ptr<Sprite> tileset_sprite;
   std::unique_ptr<ObjectCircularBuffer<Bullet, 64>> bullets;
-  std::unique_ptr<ObjectCircularBuffer<Asteroid, 1024>> asteroids;
+  std::unique_ptr<AsteroidPools> asteroids;
   std::unique_ptr<ObjectCircularBuffer<Particle, 4096>> particles;
   std::unique_ptr<ObjectCircularBuffer<Pickable, 512>> pickables;
-
-  std::vector<Music> station_music;
-  std::vector<Music> asteroid_music;
-  Music current_music;
+  std::unique_ptr<TargetIndex> targets;
+  std::unique_ptr<Scheduler> scheduler;
+  // NOTE: World events, advanced only while the world is simulated and dropped on level change
+  std::unique_ptr<TimingWheel> events;
+  std::unique_ptr<QualityGovernor> quality;
+  std::unique_ptr<Profiler> profiler;
+  std::unique_ptr<FrameArena> frame_arena; // transient allocations, reset every tick
+
+  std::unique_ptr<AudioMonitor> audio;
+  std::unique_ptr<MusicPlayer> music;
+  MusicPlaylist station_music;
+  MusicPlaylist asteroid_music;
 
   static constexpr int width  = 480;
   static constexpr int height = 270;
@@ -154,6 +178,18 @@ public:
   void unload() noexcept;
   void update();
   void draw() noexcept;
+  // dialogs, shops and transitions of the current action, drawn over the world
+  void draw_actions() const noexcept;
+  [[nodiscard]] bool has_actions() const noexcept { return !actions.empty(); }
+
+  // NOTE: Changes whenever something drawn by draw() may have changed, it stays the same while a dialog
+  //       pauses the world, so the world does not have to be rendered again
+  [[nodiscard]] uint64_t get_world_revision() const noexcept { return world_revision; }
+
+  // world rectangle seen by the camera, anything outside of it is not drawn
+  [[nodiscard]] Rectangle get_view_rect() const noexcept;
+  // view rect of the frame being drawn, wrapped entities test against it without inverting the camera each
+  [[nodiscard]] const Rectangle &get_drawn_view() const noexcept { return drawn_view; }
 
   std::unique_ptr<GUI> gui;
   Input input;
@@ -161,6 +197,10 @@ public:
   size_t crystals{ 0 };
   size_t score{ 0 };
   std::queue<Artifact> artifacts;
+  // NOTE: Crystals and artifacts change through these, they publish the events tracked by the quests
+  void add_crystals(size_t count);
+  void spend_crystals(size_t count);
+  void add_artifact(Artifact &&artifact);
   std::unordered_map<GunType, bool> guns{ { GunType::Normal, true },
                                           { GunType::Fast, false },
                                           { GunType::Assisted, false },
@@ -184,6 +224,7 @@ public:
 
   bool freeze_entities{ false };
 
+  EventBus event_bus;
   std::unordered_map<std::string, Quest> quests;
 
   std::map<size_t, MissionParameters> missions;
@@ -201,18 +242,56 @@ private:
   ~Game() noexcept;
 
   void update_game();
+  void add_scheduler_jobs();
+  size_t particle_forces_job{ 0 };
 
   Camera2D camera;
+  Rectangle drawn_view{ 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height) };
+  uint64_t world_revision{ 0 };
 
   std::array<Vector2, 100> stars;
+  bool stars_dirty{ true };
+  std::unique_ptr<SoftwareFramebuffer> star_layer;
+  std::unique_ptr<SoftwareFramebuffer> particle_layer;
+  std::unique_ptr<RenderQueue> render_queue;
+  std::unique_ptr<BackgroundLayers> background_layers;
   std::unique_ptr<Sprite> asteroid_bg_sprite;
-  void update_background() noexcept;
+  void update_background(size_t first_star, size_t last_star) noexcept;
   void draw_background() noexcept;
 
   GameState state{ GameState::MENU };
   void set_state(GameState new_state) noexcept;
 
-  std::queue<Action> actions;
+  // NOTE: Next level is populated into these back buffers during the fade-out
+  //       transition, so switching levels is only a pointer exchange
+  struct PreparedState
+  {
+    GameState state{ GameState::MENU };
+    size_t mission{ 0 };
+    size_t spawned{ 0 };
+    bool is_ready{ false };
+    std::optional<MusicPlayer::Track> music;
+    std::unique_ptr<Player> player;
+    std::shared_ptr<Room> room;
+    std::unique_ptr<ObjectCircularBuffer<Bullet, 64>> bullets;
+    std::unique_ptr<AsteroidPools> asteroids;
+    std::unique_ptr<ObjectCircularBuffer<Particle, 4096>> particles;
+    std::unique_ptr<ObjectCircularBuffer<Pickable, 512>> pickables;
+  };
+  PreparedState prepared;
+
+  void prepare_state(GameState new_state, size_t mission) noexcept;
+  bool prepare_state_step(size_t budget) noexcept;
+  void swap_prepared_state() noexcept;
+
+  // NOTE: Transitions run as scripts, each one a single coroutine with a pooled frame instead of a chain of
+  //       actions holding a std::function per step. Menus and dialogs are still actions.
+  [[nodiscard]] Script script_change_level(Level level, size_t mission, Rectangle target_rect);
+  [[nodiscard]] Script script_change_room(Room::Type room_type, std::shared_ptr<Room> old_room);
+  // walks or flies the player one tick towards target, returns true when it is reached
+  bool move_player_towards(const Vector2 &target) noexcept;
+
+  std::queue<std::variant<Action, Script>> actions;
 
   friend class GUI;
 };
@@ -14,6 +14,7 @@
 
 #include "asteroid.hpp"
 #include "dialog.hpp"
+#include "frame_arena.hpp"
 #include "player.hpp"
 #include "quest.hpp"
 #include "room.hpp"
@@ -67,18 +68,18 @@ void GUI::draw() const noexcept
 {
   const Color special_color = selection_color();
   const Game &game          = Game::get();
+  drawn_hud_state           = get_hud_state();
+
+  text_cache.collect();
 
   Vector2 text_position{ 10.0f, 10.0f };
   if (CONFIG(show_fps))
   {
-    DrawTextEx(font, TextFormat("FPS: %i", GetFPS()), text_position, font_size, 1.0f, WHITE);
+    fps_text.get(font, GetFPS()).draw(text_position, WHITE);
     text_position.y += font_size + 5.0f;
   }
 
-  const char *lives_text = "Lives: ";
-  DrawTextEx(font, lives_text, Vector2Add(text_position, Vector2{ 0.0f, 1.0f }), font_size, 1.0f, BLACK);
-  DrawTextEx(font, lives_text, text_position, font_size, 1.0f, WHITE);
-  Vector2 text_size = MeasureTextEx(font, lives_text, font_size, 1.0f);
+  Vector2 text_size = text_cache.draw(font, "Lives: ", text_position, font_size, 1.0f, WHITE, TextShadow::Drop);
   float x           = text_position.x + text_size.x + 5.0f;
   float y           = text_position.y + text_size.y * 0.5f;
   for (int i = 0; i < game.player->max_lives; i++)
@@ -93,25 +94,17 @@ void GUI::draw() const noexcept
   }
 
   text_position.y += font_size + 5.0f;
-  static uint64_t draw_score = 0;
-  uint64_t score_step        = std::max<uint64_t>(1, (game.score - draw_score) / 20);
+  uint64_t score_step = std::max<uint64_t>(1, (game.score - draw_score) / 20);
   if (draw_score < game.score)
     draw_score += score_step;
   if (draw_score > game.score)
     draw_score = game.score;
-  DrawTextEx(font,
-             TextFormat("Score: %i", draw_score),
-             Vector2Add(text_position, Vector2{ 0.0f, 1.0f }),
-             font_size,
-             1.0f,
-             BLACK);
-  DrawTextEx(font, TextFormat("Score: %i", draw_score), text_position, font_size, 1.0f, WHITE);
+  score_text.get(font, static_cast<int64_t>(draw_score)).draw(text_position, WHITE);
 
   text_position.y += font_size + 5.0f;
-  const char *crystals_text = TextFormat("Crystals: %i", game.crystals);
-  DrawTextEx(font, crystals_text, Vector2Add(text_position, Vector2{ 0.0f, 1.0f }), font_size, 1.0f, BLACK);
-  DrawTextEx(font, crystals_text, text_position, font_size, 1.0f, WHITE);
-  text_size = MeasureTextEx(font, crystals_text, font_size, 1.0f);
+  const TextLayout &crystals_layout = crystals_text.get(font, static_cast<int64_t>(game.crystals));
+  crystals_layout.draw(text_position, WHITE);
+  text_size = crystals_layout.size;
   assert(ui_crystal);
   ui_crystal->set_frame(0);
   ui_crystal->scale = Vector2{ 0.4f, 0.4f };
@@ -124,34 +117,37 @@ void GUI::draw() const noexcept
 
   if (!game.artifacts.empty())
   {
-    const char *artifacts_text = TextFormat("Artifacts: %i", game.artifacts.size());
-    DrawTextEx(font, artifacts_text, Vector2Add(text_position, Vector2{ 0.0f, 1.0f }), font_size, 1.0f, BLACK);
-    DrawTextEx(font, artifacts_text, text_position, font_size, 1.0f, WHITE);
+    artifacts_text.get(font, static_cast<int64_t>(game.artifacts.size())).draw(text_position, WHITE);
   }
 
   // draw quests
   {
-    const float quest_right_margin = 10.0f;
-    float quest_y                  = 10.0f;
-    for (const auto &[quest_name, quest] : game.quests)
+    if (quest_lines_revision != Quest::revision)
     {
+      quest_lines.clear();
+      for (const auto &[quest_name, quest] : game.quests)
+      {
 #if !defined(DEBUG_QUESTS)
-      if (!quest.is_accepted() || quest.is_reported())
-        continue;
-#else
-      DrawText(TextFormat("%i/%i", quest.progress(), quest.max_progress()),
-               Game::width - quest_right_margin - 50.0f,
-               quest_y + 5.0f,
-               font_size,
-               WHITE);
+        if (!quest.is_accepted() || quest.is_reported())
+          continue;
 #endif
 
-      const auto &quest_text =
-        TextFormat("%s: %i/%i", quest.description.c_str(), quest.progress(), quest.max_progress());
-      const float quest_x = Game::width - MeasureTextEx(font, quest_text, font_size, 1.0f).x - quest_right_margin;
-      const Color color   = quest.is_completed() ? LIME : WHITE;
-      DrawTextEx(font, quest_text, Vector2{ quest_x, quest_y + 1.0f }, font_size, 1.0f, BLACK);
-      DrawTextEx(font, quest_text, Vector2{ quest_x, quest_y }, font_size, 1.0f, color);
+        const char *quest_text =
+          TextFormat("%s: %zu/%zu", quest.description.c_str(), quest.get_progress(), quest.max_progress);
+        quest_lines.push_back(QuestLine{
+          .layout    = TextLayoutCache::layout(font, quest_text, font_size, 1.0f, TextShadow::Drop),
+          .completed = quest.is_completed() });
+      }
+      quest_lines_revision = Quest::revision;
+    }
+
+    const float quest_right_margin = 10.0f;
+    float quest_y                  = 10.0f;
+    for (const QuestLine &line : quest_lines)
+    {
+      const float quest_x = Game::width - line.layout.size.x - quest_right_margin;
+      const Color color   = line.completed ? LIME : WHITE;
+      line.layout.draw(Vector2{ quest_x, quest_y }, color);
       quest_y += font_size + 5.0f;
     }
   }
@@ -161,115 +157,142 @@ void GUI::draw() const noexcept
     float total_y = Game::height * 0.1f;
     for (const auto &message : messages)
     {
-      if (!message.timer.is_done())
-      {
-        const float letter_spacing = 0.0f;
-
-        const Vector2 text_size = MeasureTextEx(font, message.text.c_str(), font_size, letter_spacing);
-        const float message_x   = std::roundf(Game::width * 0.5f - text_size.x * 0.5f);
-        const float r           = message.timer.get_ratio() * PI;
-        const float y_offset    = std::clamp(std::sin(r), 0.0f, 0.8f) * 1.25f;
-        const float message_y   = std::roundf(-text_size.y - 8.0f + y_offset * total_y);
-
-        const float margin_w = 6.0f;
-        const float margin_h = 4.0f;
-        const Rectangle bg_rectangle{
-          message_x - margin_w, message_y - margin_h, text_size.x + margin_w * 2.0f, text_size.y + margin_h * 2.0f
-        };
-        DrawRectangleRounded(bg_rectangle, 0.5f, 12, Color{ 16, 16, 32, 220 });
-        DrawRectangleRoundedLines(bg_rectangle, 0.5f, 12, 2.0f, Color{ 16, 16, special_color.g, 250 });
-
-        for (int y = -1; y <= 1; y++)
-        {
-          for (int x = -1; x <= 1; x++)
-          {
-            DrawTextEx(
-              font, message.text.c_str(), Vector2{ message_x + x, message_y + y }, font_size, letter_spacing, BLACK);
-          }
-        }
-        DrawTextEx(
-          font, message.text.c_str(), Vector2{ message_x, message_y }, font_size, letter_spacing, special_color);
+      const float letter_spacing = 0.0f;
 
-        total_y += text_size.y * 2.0f;
-      }
+      const TextLayout &layout =
+        text_cache.get(font, message.text, font_size, letter_spacing, TextShadow::Outline, line_spacing);
+      const Vector2 text_size  = layout.size;
+      const float message_x    = std::roundf(Game::width * 0.5f - text_size.x * 0.5f);
+      const float ratio        = static_cast<float>(events.now() - message.shown_tick) / MESSAGE_DURATION_TICKS;
+      const float r            = std::clamp(ratio, 0.0f, 1.0f) * PI;
+      const float y_offset     = std::clamp(std::sin(r), 0.0f, 0.8f) * 1.25f;
+      const float message_y    = std::roundf(-text_size.y - 8.0f + y_offset * total_y);
+
+      const float margin_w = 6.0f;
+      const float margin_h = 4.0f;
+      const Rectangle bg_rectangle{
+        message_x - margin_w, message_y - margin_h, text_size.x + margin_w * 2.0f, text_size.y + margin_h * 2.0f
+      };
+      DrawRectangleRounded(bg_rectangle, 0.5f, 12, Color{ 16, 16, 32, 220 });
+      DrawRectangleRoundedLines(bg_rectangle, 0.5f, 12, 2.0f, Color{ 16, 16, special_color.g, 250 });
+
+      layout.draw(Vector2{ message_x, message_y }, special_color);
+
+      total_y += text_size.y * 2.0f;
     }
   }
 
-  if (game.player && !dialog.has_value() && !GAME.freeze_entities && game.player->can_interact())
+  if (const Interactable *entity = get_prompt_interactable(); entity)
   {
-    if (auto entity = game.player->get_interactable(); entity)
-    {
-      const std::string &interact_text = entity->get_interact_text();
-      if (entity->is_interactable() && !interact_text.empty())
-      {
-        const std::string text_a   = "Press ";
-        const std::string text     = text_a + "SPACE to " + interact_text;
-        const float letter_spacing = 0.0f;
-        const Color color          = WHITE;
-        const float margin_w       = 4.0f;
-        const float margin_h       = 2.0f;
-
-        const Vector2 pos =
-          Vector2Subtract(entity->get_sprite().position, Vector2Subtract(GAME.camera.target, GAME.camera.offset));
-        const Vector2 text_a_size = MeasureTextEx(font, text_a.c_str(), font_size, letter_spacing);
-        const Vector2 text_size   = MeasureTextEx(font, text.c_str(), font_size, letter_spacing);
-        float message_x           = std::roundf(pos.x - text_size.x * 0.5f);
-        if (message_x < margin_w)
-          message_x = margin_w;
-        else if (message_x + text_size.x > Game::width - margin_w)
-          message_x = Game::width - text_size.x - margin_w;
-
-        float message_y = std::roundf(pos.y - entity->get_sprite().get_height() * 0.5f - text_size.y - 8.0f);
-        if (message_y < margin_h)
-          message_y = margin_h;
-        else if (message_y + text_size.y > Game::height - margin_h)
-          message_y = Game::height - text_size.y - margin_h;
-
-        const Rectangle bg_rectangle{
-          message_x - margin_w, message_y - margin_h, text_size.x + margin_w * 2.0f, text_size.y + margin_h * 2.0f
-        };
-        DrawRectangleRounded(bg_rectangle, 0.5f, 12, Color{ 16, 16, 32, 220 });
-
-        for (int y = -1; y <= 1; y++)
-        {
-          for (int x = -1; x <= 1; x++)
-          {
-            DrawTextEx(font, text.c_str(), Vector2{ message_x + x, message_y + y }, font_size, letter_spacing, BLACK);
-          }
-        }
-        DrawTextEx(font, text.c_str(), Vector2{ message_x, message_y }, font_size, letter_spacing, color);
+    const std::string_view text_a = "Press ";
+    std::pmr::string text{ text_a, GAME.frame_arena.get() };
+    text += "SPACE to ";
+    text += entity->get_interact_text();
 
-        const float special_x = message_x + text_a_size.x;
-        const float special_y = message_y;
-        DrawTextEx(font, "SPACE", Vector2{ special_x, special_y }, font_size, letter_spacing, special_color);
-      }
-    }
+    const float letter_spacing = 0.0f;
+    const Color color          = WHITE;
+    const float margin_w       = 4.0f;
+    const float margin_h       = 2.0f;
+
+    const Vector2 pos =
+      Vector2Subtract(entity->get_sprite().position, Vector2Subtract(GAME.camera.target, GAME.camera.offset));
+    const Vector2 text_a_size = text_cache.get(font, text_a, font_size, letter_spacing).size;
+    const TextLayout &layout  = text_cache.get(font, text, font_size, letter_spacing, TextShadow::Outline);
+    const Vector2 text_size   = layout.size;
+    float message_x           = std::roundf(pos.x - text_size.x * 0.5f);
+    if (message_x < margin_w)
+      message_x = margin_w;
+    else if (message_x + text_size.x > Game::width - margin_w)
+      message_x = Game::width - text_size.x - margin_w;
+
+    float message_y = std::roundf(pos.y - entity->get_sprite().get_height() * 0.5f - text_size.y - 8.0f);
+    if (message_y < margin_h)
+      message_y = margin_h;
+    else if (message_y + text_size.y > Game::height - margin_h)
+      message_y = Game::height - text_size.y - margin_h;
+
+    const Rectangle bg_rectangle{
+      message_x - margin_w, message_y - margin_h, text_size.x + margin_w * 2.0f, text_size.y + margin_h * 2.0f
+    };
+    DrawRectangleRounded(bg_rectangle, 0.5f, 12, Color{ 16, 16, 32, 220 });
+
+    layout.draw(Vector2{ message_x, message_y }, color);
+
+    const float special_x = message_x + text_a_size.x;
+    const float special_y = message_y;
+    text_cache.draw(font, "SPACE", Vector2{ special_x, special_y }, font_size, letter_spacing, special_color);
   }
 
   if (game.state == GameState::PLAYING_ASTEROIDS)
   {
     if (game.survive_time > 0.0f)
     {
-      Color color                = WHITE;
-      const float survive_time   = game.survive_time;
-      const float seconds        = std::floor(std::fmod(survive_time, 60.0f));
-      const float milliseconds   = std::floor(std::fmod(survive_time, 1.0f) * 100.0f);
-      const std::string text     = TextFormat("Survive: %02.0f:%02.0f", seconds, milliseconds);
-      const float letter_spacing = 0.0f;
-      const Vector2 text_size    = MeasureTextEx(mono_font, text.c_str(), font_size, letter_spacing);
+      Color color                 = WHITE;
+      const float survive_time    = game.survive_time;
+      const float seconds         = std::floor(std::fmod(survive_time, 60.0f));
+      const float milliseconds    = std::floor(std::fmod(survive_time, 1.0f) * 100.0f);
+      const TextLayout &layout =
+        survive_text.get(mono_font, static_cast<int64_t>(seconds), static_cast<int64_t>(milliseconds));
       if (seconds < 10.0f)
         color = special_color;
 
-      DrawTextEx(mono_font,
-                 text.c_str(),
-                 Vector2{ Game::width * 0.5f - text_size.x * 0.5f, font_size + 10.0f },
-                 font_size,
-                 letter_spacing,
-                 color);
+      layout.draw(Vector2{ Game::width * 0.5f - layout.size.x * 0.5f, font_size + 10.0f }, color);
     }
   }
 }
 
+const TextLayout &GUI::get_price_layout(size_t price) const
+{
+  auto it = price_layouts.find(price);
+  if (it == price_layouts.end())
+    it = price_layouts.emplace(price, TextLayoutCache::layout(font, TextFormat("%4zu", price), font_size, 1.0f)).first;
+  return it->second;
+}
+
+bool GUI::needs_redraw() const noexcept
+{
+  const Game &game = Game::get();
+
+  // NOTE: Animated parts of the HUD
+  if (CONFIG(show_fps) || !messages.empty() || draw_score != game.score || get_prompt_interactable())
+    return true;
+
+  if (game.state == GameState::PLAYING_ASTEROIDS && game.survive_time > 0.0f)
+    return true;
+
+  return get_hud_state() != drawn_hud_state;
+}
+
+GUI::HudState GUI::get_hud_state() const noexcept
+{
+  const Game &game = Game::get();
+
+  HudState state;
+  if (game.player)
+  {
+    state.lives     = game.player->lives;
+    state.max_lives = game.player->max_lives;
+  }
+  state.crystals  = game.crystals;
+  state.artifacts = game.artifacts.size();
+  state.quests    = Quest::revision;
+
+  return state;
+}
+
+const Interactable *GUI::get_prompt_interactable() const noexcept
+{
+  const Game &game = Game::get();
+  if (!game.player || dialog.has_value() || game.freeze_entities || !game.player->can_interact())
+    return nullptr;
+
+  const Interactable *entity = game.player->get_interactable();
+  if (!entity || !entity->is_interactable() || entity->get_interact_text().empty())
+    return nullptr;
+
+  return entity;
+}
+
 void GUI::set_dialog(const Dialog &new_dialog) noexcept
 {
   dialog = new_dialog;
@@ -300,15 +323,10 @@ void GUI::draw_dialog() const noexcept
 
   // name
   {
-    DrawTextEx(font,
-               dialog->actor_name.c_str(),
-               Vector2{ dialog_x + 10.0f + 1.0f, dialog_y + 10.0f + 1.0f },
-               font_size,
-               2.0f,
-               DARKBLUE);
-    DrawTextEx(
-      font, dialog->actor_name.c_str(), Vector2{ dialog_x + 10.0f, dialog_y + 10.0f }, font_size, 2.0f, RAYWHITE);
-    auto name_size = MeasureTextEx(font, dialog->actor_name.c_str(), font_size, 2.0f);
+    const TextLayout &name_layout = text_cache.get(font, dialog->actor_name, font_size, 2.0f);
+    name_layout.draw(Vector2{ dialog_x + 10.0f + 1.0f, dialog_y + 10.0f + 1.0f }, DARKBLUE);
+    name_layout.draw(Vector2{ dialog_x + 10.0f, dialog_y + 10.0f }, RAYWHITE);
+    const Vector2 &name_size = name_layout.size;
     DrawLineEx(Vector2{ dialog_x + 10.0f, dialog_y + 10.0f + name_size.y },
                Vector2{ dialog_x + 10.0f + name_size.x, dialog_y + 10.0f + name_size.y },
                1.0f,
@@ -318,8 +336,6 @@ void GUI::draw_dialog() const noexcept
   // text
   {
     const float letter_spacing = 0.0f;
-    const float line_spacing   = font_size - 2.0f;
-    SetTextLineSpacing(line_spacing);
     const std::string &t = dialog->text;
 
     const std::unordered_map<char, Color> font_colors{
@@ -375,9 +391,9 @@ void GUI::draw_dialog() const noexcept
           continue;
         }
 
-        const auto text = TextFormat("%c", c);
-        DrawTextEx(dialog_font, text, Vector2{ x, y }, font_size, 0.0f, color);
-        x += MeasureTextEx(dialog_font, text, font_size, 0.0f).x + letter_spacing;
+        const TextLayout &glyph = text_cache.get(dialog_font, std::string_view(&t[i], 1), font_size, 0.0f);
+        glyph.draw(Vector2{ x, y }, color);
+        x += glyph.size.x + letter_spacing;
         if (x > dialog_x + dialog_width - 10.0f)
         {
           x = text_x;
@@ -387,15 +403,12 @@ void GUI::draw_dialog() const noexcept
     }
     else
     {
-      DrawTextEx(dialog_font,
-                 t.c_str(),
-                 Vector2{ dialog_x + 10.0f, dialog_y + 10.0f + font_size + 5.0f },
-                 font_size,
-                 letter_spacing,
-                 WHITE);
+      text_cache.get(dialog_font, t, font_size, letter_spacing, TextShadow::None, line_spacing)
+        .draw(Vector2{ dialog_x + 10.0f, dialog_y + 10.0f + font_size + 5.0f }, WHITE);
     }
   }
-  const auto text_size = MeasureTextEx(dialog_font, dialog->text.c_str(), font_size, 1.0f);
+  const auto text_size =
+    text_cache.get(dialog_font, dialog->text, font_size, 1.0f, TextShadow::None, line_spacing).size;
 
   // responses
   const Color selected_color = selection_color();
@@ -404,21 +417,13 @@ void GUI::draw_dialog() const noexcept
   for (size_t i = 0; i < dialog->responses.size(); i++)
   {
     const DialogResponse &response = dialog->responses[i];
-    DrawTextEx(dialog_font,
-               response.text.c_str(),
-               Vector2{ response_x, response_y + (font_size + 5.0f) * i },
-               font_size,
-               1.0f,
-               WHITE);
+    const TextLayout &layout       = text_cache.get(dialog_font, response.text, font_size, 1.0f);
+    const Vector2 position{ response_x, response_y + (font_size + 5.0f) * i };
+    layout.draw(position, WHITE);
 
     if (selected_index.has_value() && selected_index.value() == i)
     {
-      DrawTextEx(dialog_font,
-                 response.text.c_str(),
-                 Vector2{ response_x, response_y + (font_size + 5.0f) * i },
-                 font_size,
-                 1.0f,
-                 selected_color);
+      layout.draw(position, selected_color);
 
       const float triangle_size = 8.0f;
       const float triangle_x    = dialog_x + 10.0f;
@@ -438,42 +443,35 @@ bool GUI::is_active() const
 
 void GUI::draw_shop_items(const std::vector<ShopItem> &items) const noexcept
 {
-  std::unordered_map<ShopItem::AvailabilityReason, std::string> buy_text_map{
-    { ShopItem::AvailabilityReason::Available, "Buy" },
-    { ShopItem::AvailabilityReason::AlreadyOwned, "Owned" },
-    { ShopItem::AvailabilityReason::NotEnoughMoney, "Cannot afford" },
-    { ShopItem::AvailabilityReason::NotAvailable, "Sold out" },
-  };
+  // Available, NotEnoughMoney, AlreadyOwned, NotAvailable
+  static constexpr const BuyTexts buy_texts{ "Buy", "Cannot afford", "Owned", "Sold out" };
 
   const std::string header = "Upgrade Ship";
 
-  draw_selectable_items(header, items, buy_text_map);
+  draw_selectable_items(header, items, &buy_texts);
 }
 
 void GUI::draw_ship_items(const std::vector<ShopItem> &items) const noexcept
 {
-  std::unordered_map<ShopItem::AvailabilityReason, std::string> buy_text_map{
-    { ShopItem::AvailabilityReason::Available, "Equip" },
-    { ShopItem::AvailabilityReason::AlreadyOwned, "Equipped" },
-    { ShopItem::AvailabilityReason::NotEnoughMoney, "" },
-    { ShopItem::AvailabilityReason::NotAvailable, "" },
-  };
+  // Available, NotEnoughMoney, AlreadyOwned, NotAvailable
+  static constexpr const BuyTexts buy_texts{ "Equip", "", "Equipped", "" };
 
   const std::string header = "Modify Ship";
 
-  draw_selectable_items(header, items, buy_text_map);
+  draw_selectable_items(header, items, &buy_texts);
 }
 
 void GUI::draw_ship_control(const std::vector<ShopItem> &items) const noexcept
 {
-  draw_selectable_items("", items, {});
+  draw_selectable_items("", items, nullptr);
 }
 
-void GUI::draw_selectable_items(
-  const std::string &header,
-  const std::vector<ShopItem> &items,
-  const std::unordered_map<ShopItem::AvailabilityReason, std::string> &buy_text_map) const noexcept
+void GUI::draw_selectable_items(const std::string &header,
+                                const std::vector<ShopItem> &items,
+                                const BuyTexts *buy_texts) const noexcept
 {
+  static_assert(std::tuple_size_v<BuyTexts> == magic_enum::enum_count<ShopItem::AvailabilityReason>());
+
   const float MARGIN{ 10.0f };
   const Color selected_color = selection_color();
   const Color scrollbar_color{ 255, 255, 255, 180 };
@@ -492,14 +490,10 @@ void GUI::draw_selectable_items(
   Vector2 header_text_size{ 0.0f, -MARGIN };
   if (!header.empty())
   {
-    const char *header_text = header.c_str();
-    header_text_size        = MeasureTextEx(font, header_text, font_size, 1.0f);
-    DrawTextEx(font,
-               header_text,
-               Vector2{ dialog_x + std::roundf(dialog_width / 2.0f - header_text_size.x / 2.0f), dialog_y + MARGIN },
-               font_size,
-               1.0f,
-               WHITE);
+    const TextLayout &header_layout = text_cache.get(font, header, font_size, 1.0f);
+    header_text_size                = header_layout.size;
+    header_layout.draw(
+      Vector2{ dialog_x + std::roundf(dialog_width / 2.0f - header_text_size.x / 2.0f), dialog_y + MARGIN }, WHITE);
 
     DrawLineV(Vector2{ dialog_x + MARGIN, dialog_y + MARGIN + header_text_size.y + MARGIN },
               Vector2{ dialog_x + dialog_width - MARGIN, dialog_y + MARGIN + header_text_size.y + MARGIN },
@@ -545,11 +539,9 @@ void GUI::draw_selectable_items(
 #endif
 
     // skip unavailable items if state explicitly defined as empty
-    if (!buy_text_map.empty())
-    {
-      if (!buy_text_map.contains(availability) || buy_text_map.at(availability).empty())
-        continue;
-    }
+    const std::string_view buy_text = buy_texts ? (*buy_texts)[static_cast<size_t>(availability)] : "";
+    if (buy_texts && buy_text.empty())
+      continue;
 
     if (availability != ShopItem::AvailabilityReason::Available)
       color = DARKGRAY;
@@ -600,51 +592,44 @@ void GUI::draw_selectable_items(
     DrawRectangle(item_icon_x, item_icon_y, item_icon_size, item_icon_size, Color{ 16, 16, 32, 200 });
 
     // item name
-    const Vector2 item_name_size = MeasureTextEx(font, item.name.c_str(), font_size, 1.0f);
-    DrawTextEx(font,
-               item.name.c_str(),
-               Vector2{ item_icon_x + item_icon_size + MARGIN * 0.5f + 1.0f,
-                        item_icon_y + item_icon_size * 0.5f - item_name_size.y + 1.0f },
-               font_size,
-               1.0f,
-               BLACK);
-    DrawTextEx(
-      font,
-      item.name.c_str(),
-      Vector2{ item_icon_x + item_icon_size + MARGIN * 0.5f, item_icon_y + item_icon_size * 0.5f - item_name_size.y },
-      font_size,
-      1.0f,
-      color);
+    const TextLayout &item_name_layout = text_cache.get(font, item.name, font_size, 1.0f);
+    const Vector2 item_name_position{ item_icon_x + item_icon_size + MARGIN * 0.5f,
+                                      item_icon_y + item_icon_size * 0.5f - item_name_layout.size.y };
+    item_name_layout.draw(Vector2Add(item_name_position, Vector2{ 1.0f, 1.0f }), BLACK);
+    item_name_layout.draw(item_name_position, color);
 
     // item description
     if (!item.description.empty())
     {
-      DrawTextEx(dialog_font,
-                 item.description.c_str(),
-                 Vector2{ item_icon_x + item_icon_size + MARGIN * 0.5f, item_icon_y + item_icon_size * 0.5f },
-                 font_size,
-                 0.0f,
-                 color);
+      text_cache.draw(dialog_font,
+                      item.description,
+                      Vector2{ item_icon_x + item_icon_size + MARGIN * 0.5f, item_icon_y + item_icon_size * 0.5f },
+                      font_size,
+                      0.0f,
+                      color,
+                      TextShadow::None,
+                      BLACK,
+                      line_spacing);
     }
 
     // buy button
-    if (buy_text_map.contains(availability))
+    if (buy_texts)
     {
-      const char *buy_text          = buy_text_map.at(availability).c_str();
-      const char *price_text        = TextFormat("%4zu", item.price);
-      const Vector2 buy_text_size   = MeasureTextEx(font, buy_text, font_size, 0.0f);
-      const Vector2 price_text_size = MeasureTextEx(font, price_text, font_size, 1.0f);
-      const float buy_button_w      = std::max(80.0f, buy_text_size.x + price_text_size.x + MARGIN * 3.0f);
-      const float buy_button_h      = 20.0f;
-      const float buy_button_x      = std::roundf(dialog_x + dialog_width - buy_button_w - MARGIN * 1.5f);
-      const float buy_button_y      = std::roundf(item_box_y + item_box_h * 0.5f - buy_button_h * 0.5f);
+      const TextLayout &buy_layout   = text_cache.get(font, buy_text, font_size, 0.0f);
+      const TextLayout &price_layout = get_price_layout(item.price);
+      const Vector2 buy_text_size    = buy_layout.size;
+      const Vector2 price_text_size  = price_layout.size;
+      const float buy_button_w       = std::max(80.0f, buy_text_size.x + price_text_size.x + MARGIN * 3.0f);
+      const float buy_button_h       = 20.0f;
+      const float buy_button_x       = std::roundf(dialog_x + dialog_width - buy_button_w - MARGIN * 1.5f);
+      const float buy_button_y       = std::roundf(item_box_y + item_box_h * 0.5f - buy_button_h * 0.5f);
       DrawRectangle(buy_button_x, buy_button_y, buy_button_w, buy_button_h, Color{ 16, 16, 32, 200 });
       DrawRectangleLinesEx(
         Rectangle{ buy_button_x, buy_button_y, buy_button_w, buy_button_h }, is_selected ? 2.0f : 1.0f, color);
 
       const float buy_text_x = std::roundf(buy_button_x + MARGIN);
       const float buy_text_y = std::roundf(buy_button_y + buy_button_h * 0.5f - buy_text_size.y * 0.5f);
-      DrawTextEx(font, buy_text, Vector2{ buy_text_x, buy_text_y }, font_size, 0.0f, color);
+      buy_layout.draw(Vector2{ buy_text_x, buy_text_y }, color);
 
       if (item.price > 0)
       {
@@ -652,7 +637,7 @@ void GUI::draw_selectable_items(
           std::roundf(buy_button_x + buy_button_w - price_text_size.x - MARGIN - ui_crystal->get_width() * 0.4f);
         const float price_text_y = std::roundf(buy_button_y + buy_button_h * 0.5f - price_text_size.y * 0.5f);
 
-        DrawTextEx(font, price_text, Vector2{ price_text_x, price_text_y }, font_size, 1.0f, color);
+        price_layout.draw(Vector2{ price_text_x, price_text_y }, color);
         ui_crystal->set_frame(0);
         ui_crystal->scale = Vector2{ 0.4f, 0.4f };
         ui_crystal->set_centered();
@@ -699,13 +684,9 @@ void GUI::draw_selectable_items(
   DrawRectangle(exit_button_x, exit_button_y, exit_button_w, exit_button_h, Color{ 16, 16, 32, 200 });
   DrawRectangleLinesEx(
     Rectangle{ exit_button_x, exit_button_y, exit_button_w, exit_button_h }, selected_exit ? 2.0f : 1.0f, color);
-  const Vector2 exit_text_size = MeasureTextEx(font, "Exit", font_size, 1.0f);
-  DrawTextEx(
-    font,
-    "Exit",
-    Vector2{ exit_button_x + exit_button_w * 0.5f - std::roundf(exit_text_size.x * 0.5f), exit_button_y + 5.0f },
-    font_size,
-    1.0f,
+  const TextLayout &exit_layout = text_cache.get(font, "Exit", font_size, 1.0f);
+  exit_layout.draw(
+    Vector2{ exit_button_x + exit_button_w * 0.5f - std::roundf(exit_layout.size.x * 0.5f), exit_button_y + 5.0f },
     color);
 }
 
@@ -750,9 +731,15 @@ void GUI::handle_accepting_index(std::optional<size_t> &index, std::function<voi
   }
 }
 
+void GUI::update()
+{
+  events.advance();
+}
+
 void GUI::show_message(const std::string &new_message)
 {
-  Message message{ new_message };
-  message.timer.start();
-  messages.push_back(message);
+  messages.push_back(Message{ .text = new_message, .shown_tick = events.now() });
+
+  // NOTE: All messages last the same time, so the expiring one is always the oldest
+  events.schedule(MESSAGE_DURATION_TICKS, [this]() { messages.pop_front(); });
 }
@@ -1,17 +1,24 @@
 #pragma once
 
+#include <array>
 #include <list>
 #include <memory>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <raylib.h>
 #include <raymath.h>
 
 #include "dialog.hpp"
 #include "sound_manager.hpp"
+#include "text_layout.hpp"
 #include "timer.hpp"
+#include "timing_wheel.hpp"
 
 class Sprite;
+class Interactable;
 
 class GUI
 {
@@ -21,6 +28,8 @@ public:
 
   void update();
   void draw() const noexcept;
+  // false when draw() would produce the same image as the previous time
+  [[nodiscard]] bool needs_redraw() const noexcept;
 
   bool is_active() const;
 
@@ -37,8 +46,8 @@ public:
 
   void show_message(const std::string &message);
 
-  SMSound sound_select = SoundManager::get("resources/select.wav");
-  SMSound sound_accept = SoundManager::get("resources/accept.wav");
+  SMSound sound_select = SoundManager::get("resources/select.qoa");
+  SMSound sound_accept = SoundManager::get("resources/accept.qoa");
 
 private:
   std::unique_ptr<Sprite> ui_crystal;
@@ -51,20 +60,68 @@ private:
   Font mono_font;
 
   const float font_size{ 10.0f };
+  // NOTE: Every multi-line text uses it, the raylib global line spacing is not used by the cached layouts
+  const float line_spacing{ font_size - 2.0f };
 
-  void draw_selectable_items(
-    const std::string &header,
-    const std::vector<ShopItem> &items,
-    const std::unordered_map<ShopItem::AvailabilityReason, std::string> &buy_text_map) const noexcept;
+  mutable TextLayoutCache text_cache;
+
+  // NOTE: HUD numbers keep their own layout and are formatted again only when their value changes
+  mutable ValueText fps_text{ "FPS: %lld", font_size, 1.0f };
+  mutable ValueText score_text{ "Score: %lld", font_size, 1.0f, TextShadow::Drop };
+  mutable ValueText crystals_text{ "Crystals: %lld", font_size, 1.0f, TextShadow::Drop };
+  mutable ValueText artifacts_text{ "Artifacts: %lld", font_size, 1.0f, TextShadow::Drop };
+  mutable ValueText survive_text{ "Survive: %02lld:%02lld", font_size, 0.0f };
+  mutable std::unordered_map<size_t, TextLayout> price_layouts;
+  [[nodiscard]] const TextLayout &get_price_layout(size_t price) const;
+
+  struct QuestLine
+  {
+    TextLayout layout;
+    bool completed{ false };
+  };
+  // laid out again when Quest::revision changes
+  mutable std::vector<QuestLine> quest_lines;
+  mutable std::optional<uint64_t> quest_lines_revision;
+
+  // buy button text indexed by ShopItem::AvailabilityReason, an empty text hides the item
+  using BuyTexts = std::array<std::string_view, 4>;
+
+  // items have no buy button when buy_texts is null
+  void draw_selectable_items(const std::string &header,
+                             const std::vector<ShopItem> &items,
+                             const BuyTexts *buy_texts) const noexcept;
+
+  static constexpr const uint32_t MESSAGE_DURATION_TICKS{ 240 };
 
   struct Message
   {
     std::string text;
-    Timer timer{ FRAMES(240), 0.0f };
+    uint64_t shown_tick{ 0 };
   };
   std::list<Message> messages;
 
+  // NOTE: GUI events keep running while the world is paused
+  TimingWheel events;
+
   mutable std::unordered_map<std::string, Sprite> name_icon_map;
 
+  // NOTE: Everything the HUD shows that is not animated, compared against the last drawn state
+  struct HudState
+  {
+    int lives{ 0 };
+    int max_lives{ 0 };
+    size_t crystals{ 0 };
+    size_t artifacts{ 0 };
+    uint64_t quests{ 0 }; // Quest::revision
+
+    bool operator==(const HudState &) const = default;
+  };
+  [[nodiscard]] HudState get_hud_state() const noexcept;
+  mutable HudState drawn_hud_state;
+  mutable uint64_t draw_score{ 0 };
+
+  // entity whose interaction prompt is shown, if any
+  [[nodiscard]] const Interactable *get_prompt_interactable() const noexcept;
+
   friend class Game;
 };
@@ -4,6 +4,7 @@
 #include "dialog.hpp"
 #include "game.hpp"
 #include "player_character.hpp"
+#include "timing_wheel.hpp"
 #include "utils.hpp"
 
 void Interactable::draw() const
@@ -12,6 +13,12 @@ void Interactable::draw() const
   sprite.draw();
 }
 
+Rectangle Interactable::get_bounds() const
+{
+  // NOTE: draw() centers the sprite first, the origin left by the last draw is stale when the scale changed since
+  return sprite.get_bounds(sprite.get_centered_origin());
+}
+
 Station::Station()
 {
   sprite = Sprite{ "resources/station.aseprite", "idle" };
@@ -86,6 +93,8 @@ void DockedShip::interact()
   GAME.schedule_action_ship_control(this);
 }
 
+static constexpr const uint64_t WANDER_FIRST_DECISION_TICKS{ 60 };
+
 DialogEntity::DialogEntity(const Vector2 &position, const std::string &name)
   : Interactable{}
   , dialogs{ Dialog::load_dialogs(name) }
@@ -101,6 +110,19 @@ DialogEntity::DialogEntity(const Vector2 &position, const std::string &name)
     direction = Direction::Up;
 }
 
+DialogEntity::~DialogEntity()
+{
+  if (GAME.events)
+    GAME.events->cancel(wander_event);
+}
+
+void DialogEntity::schedule_events(TimingWheel &events)
+{
+  events.cancel(wander_event);
+  if (wander)
+    wander_event = events.schedule(WANDER_FIRST_DECISION_TICKS, [this]() { decide_wander(); });
+}
+
 void DialogEntity::update()
 {
   if (!wander)
@@ -113,60 +135,10 @@ void DialogEntity::update()
   {
     auto &position = sprite.position;
 
-    if (wander_timer.is_done())
-    {
-      velocity = Vector2Zero();
-
-      if (GetRandomValue(0, 1) == 0)
-      {
-        const Direction dir    = static_cast<Direction>(GetRandomValue(0, 3));
-        const float walk_speed = 0.5f;
-        switch (dir)
-        {
-          case Direction::Up:
-            velocity.y = -walk_speed;
-            break;
-          case Direction::Down:
-            velocity.y = walk_speed;
-            break;
-          case Direction::Left:
-            velocity.x = -walk_speed;
-            break;
-          case Direction::Right:
-            velocity.x = walk_speed;
-            break;
-        }
-
-        if (Vector2Distance(start_position, position) > 50.0f)
-        {
-          if (position.x < start_position.x + 10.0f)
-            velocity.x = 1.0f;
-          else if (position.x > start_position.x - 10.0f)
-            velocity.x = -1.0f;
-          else
-            velocity.x = 0.0f;
-
-          if (position.y < start_position.y - 10.0f)
-            velocity.y = 1.0f;
-          else if (position.y > start_position.y + 10.0f)
-            velocity.y = -1.0f;
-          else
-            velocity.y = 0.0f;
-        }
-
-        velocity = Vector2Normalize(velocity);
-      }
-
-      wander_timer.set_max_time(static_cast<float>(GetRandomValue(2, 5)));
-      wander_timer.start();
-    }
-
     position.x += velocity.x;
     position.y += velocity.y;
 
     // TODO: check collisions
-
-    wander_timer.update();
   }
 
   if (velocity.x < 0.0f)
@@ -195,6 +167,58 @@ void DialogEntity::update()
   }
 }
 
+void DialogEntity::decide_wander()
+{
+  if (!wander)
+    return;
+
+  const auto &position = sprite.position;
+
+  velocity = Vector2Zero();
+
+  if (GetRandomValue(0, 1) == 0)
+  {
+    const Direction dir    = static_cast<Direction>(GetRandomValue(0, 3));
+    const float walk_speed = 0.5f;
+    switch (dir)
+    {
+      case Direction::Up:
+        velocity.y = -walk_speed;
+        break;
+      case Direction::Down:
+        velocity.y = walk_speed;
+        break;
+      case Direction::Left:
+        velocity.x = -walk_speed;
+        break;
+      case Direction::Right:
+        velocity.x = walk_speed;
+        break;
+    }
+
+    if (Vector2Distance(start_position, position) > 50.0f)
+    {
+      if (position.x < start_position.x + 10.0f)
+        velocity.x = 1.0f;
+      else if (position.x > start_position.x - 10.0f)
+        velocity.x = -1.0f;
+      else
+        velocity.x = 0.0f;
+
+      if (position.y < start_position.y - 10.0f)
+        velocity.y = 1.0f;
+      else if (position.y > start_position.y + 10.0f)
+        velocity.y = -1.0f;
+      else
+        velocity.y = 0.0f;
+    }
+
+    velocity = Vector2Normalize(velocity);
+  }
+
+  wander_event = GAME.events->schedule(GetRandomValue(2, 5) * 60, [this]() { decide_wander(); });
+}
+
 void DialogEntity::draw() const noexcept
 {
   sprite.tint = WHITE;
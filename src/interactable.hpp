@@ -5,6 +5,7 @@
 #include "sound_manager.hpp"
 #include "sprite.hpp"
 #include "timer.hpp"
+#include "timing_wheel.hpp"
 #include "utils.hpp"
 
 class Interactable
@@ -14,11 +15,15 @@ public:
 
   virtual void update(){};
   virtual void draw() const;
+  // arms the timed events of the entity, called when its room is installed and the wheel may have been cleared
+  virtual void schedule_events(TimingWheel &){};
   virtual void interact()                                = 0;
   virtual std::string get_interact_text() const noexcept = 0;
 
   Sprite &get_sprite() noexcept { return sprite; }
   [[nodiscard]] const Sprite &get_sprite() const noexcept { return sprite; }
+  // world rectangle covered by draw(), from the current position and scale
+  [[nodiscard]] Rectangle get_bounds() const;
 
   [[nodiscard]] virtual bool is_interactable() const { return true; }
 
@@ -36,7 +41,7 @@ public:
   [[nodiscard]] std::string get_interact_text() const noexcept override { return "dock"; }
 
 private:
-  SMSound sound_warp = SoundManager::copy("resources/warp.wav");
+  SMSound sound_warp = SoundManager::get("resources/warp.qoa");
 };
 
 class DockedShip final : public Interactable
@@ -52,9 +57,11 @@ class DialogEntity final : public Interactable
 {
 public:
   DialogEntity(const Vector2 &position, const std::string &name);
+  ~DialogEntity() override;
   void update() override;
   void draw() const noexcept override;
   void interact() override;
+  void schedule_events(TimingWheel &events) override;
 
   [[nodiscard]] const Dialog &dialog() const { return get_dialog(dialog_id); }
 
@@ -67,7 +74,7 @@ public:
 
   [[nodiscard]] std::string get_interact_text() const noexcept override { return "talk"; }
 
-  bool wander{ false };
+  bool wander{ false }; // read by schedule_events()
 
 private:
   [[nodiscard]] const Dialog &get_dialog(const DialogId &dialog_id) const
@@ -95,9 +102,11 @@ private:
   std::string default_animation_tag{ "idle_down" };
   Vector2 velocity{ 0.0f, 0.0f };
   Vector2 start_position{ 0.0f, 0.0f };
-  Timer wander_timer{ 1.0f };
+  TimingWheel::Handle wander_event{};
   Direction direction{ Direction::Down };
   std::string name{};
+
+  void decide_wander();
 };
 
 class Blocker : public Interactable
@@ -11,12 +11,16 @@
 #include <emscripten/emscripten.h>
 #endif
 
+#include "audio_monitor.hpp"
+#include "frame_graph.hpp"
+#include "frame_arena.hpp"
 #include "game.hpp"
 #include "player.hpp"
-#include "render_pass.hpp"
+#include "profiler.hpp"
+#include "quality_governor.hpp"
+#include "scheduler.hpp"
 #include "utils.hpp"
 
-const constexpr int AUDIO_BUFFER_SIZE   = (4096 * 12);
 const constexpr size_t MAX_UPDATE_STEPS = 3;
 
 const constexpr int window_width  = Game::width * 2;
@@ -24,8 +28,7 @@ const constexpr int window_height = Game::height * 2;
 
 const constexpr bool integer_scaling = false;
 
-static std::unique_ptr<RenderPass> game_render_pass;
-static std::unique_ptr<RenderPass> ui_render_pass;
+static std::unique_ptr<FrameGraph> frame_graph;
 
 void update_draw_frame()
 {
@@ -53,11 +56,19 @@ void update_draw_frame()
 
   game.input.gather(); // only sets the input state, does not unset it
   bool updated = false;
+
+  // NOTE: The profiler frame starts before the updates, so the update sections are attributed to it
+  game.profiler->begin_frame();
+
+  const double update_start = GetTime();
   for (size_t steps = 0; accumulator >= interval && steps < MAX_UPDATE_STEPS; ++steps)
   {
     accumulator -= interval;
 
-    game.update();
+    {
+      const auto section = game.profiler->scope("update");
+      game.update();
+    }
 
     updated = true;
 
@@ -67,23 +78,45 @@ void update_draw_frame()
     game.input.update();
   }
 
+  // NOTE: Sounds triggered by all the update steps of the frame are merged
+  SoundManager::update();
+
+  if (game.audio->update(dt))
+    game.music->set_buffer_frames(game.audio->get_buffer_frames());
+
+  const double update_end = GetTime();
+
   BeginDrawing();
   {
     if (updated)
+      frame_graph->render(*game.profiler);
+
     {
-      game_render_pass->render();
-      ui_render_pass->render();
+      const auto section = game.profiler->scope("composite");
+      ClearBackground(BLACK);
+      frame_graph->draw(render_destination);
     }
 
-    ClearBackground(BLACK);
-    game_render_pass->draw(render_destination);
-    ui_render_pass->draw(render_destination);
+    game.profiler->end_frame();
+
+    game.quality->report_frame(static_cast<float>(update_end - update_start) * 1000.0f,
+                               static_cast<float>(GetTime() - update_end) * 1000.0f);
 
 #if defined(DEBUG)
     game.input.debug_draw();
 
     DrawText(TextFormat("FPS: %4.0f", fps), 40, 20, 10, GOLD);
     DrawText(TextFormat(" DT: %8.8f", dt), 40, 30, 10, GOLD);
+
+    if (CONFIG(show_debug))
+    {
+      game.quality->draw_debug();
+      game.scheduler->draw_debug();
+      frame_graph->draw_debug();
+      game.profiler->draw_debug();
+      game.audio->draw_debug();
+      game.frame_arena->draw_debug();
+    }
 #endif
   }
   EndDrawing();
@@ -108,7 +141,7 @@ int main(void)
   InitWindow(window_width, window_height, "SPACE SOMETHING");
   SetExitKey(KEY_NULL);
 
-  SetAudioStreamBufferSizeDefault(AUDIO_BUFFER_SIZE);
+  SetAudioStreamBufferSizeDefault(AudioMonitor::DEFAULT_BUFFER_FRAMES);
   InitAudioDevice();
   SetTargetFPS(60);
 
@@ -119,16 +152,44 @@ int main(void)
   Game &game = Game::get();
   game.init();
 
-  game_render_pass = std::make_unique<RenderPass>(Game::width, Game::height);
-  ui_render_pass   = std::make_unique<RenderPass>(Game::width, Game::height);
-
-  game_render_pass->render_func = [&game]()
-  {
-    ClearBackground(BLACK);
-    game.draw();
-  };
-
-  ui_render_pass->render_func = [&game]() { game.gui->draw(); };
+  frame_graph = std::make_unique<FrameGraph>(Game::width, Game::height);
+
+  // NOTE: The world is only rendered again when it changed, so it is not redrawn under dialogs and shops
+  static uint64_t rendered_world_revision = 0;
+  frame_graph->add_pass({ .name     = "world",
+                          .is_dirty = [&game]() { return game.get_world_revision() != rendered_world_revision; },
+                          .render =
+                            [&game]()
+                          {
+                            ClearBackground(BLACK);
+                            game.draw();
+                            rendered_world_revision = game.get_world_revision();
+                          },
+                          .composite = false });
+
+  // NOTE: Actions are drawn over a copy of the world, so they blend with it exactly as before.
+  //       Rendered once more after the last action is done, to remove it.
+  static bool rendered_actions = true;
+  frame_graph->add_pass({ .name     = "scene",
+                          .inputs   = { "world" },
+                          .is_dirty = [&game]() { return game.has_actions() || rendered_actions; },
+                          .render =
+                            [&game]()
+                          {
+                            const Texture2D &world = frame_graph->get_output("world");
+                            DrawTextureRec(world, texture_rect_flipped(world), Vector2Zero(), WHITE);
+                            game.draw_actions();
+                            rendered_actions = game.has_actions();
+                          } });
+
+  frame_graph->add_pass({ .name     = "ui",
+                          .is_dirty = [&game]() { return game.gui->needs_redraw(); },
+                          .render =
+                            [&game]()
+                          {
+                            const auto section = game.profiler->scope("gui");
+                            game.gui->draw();
+                          } });
 
 #if defined(EMSCRIPTEN)
   emscripten_set_main_loop(update_draw_frame, 0, 1);
@@ -142,8 +203,7 @@ int main(void)
   }
 #endif
 
-  game_render_pass.reset();
-  ui_render_pass.reset();
+  frame_graph.reset();
 
   game.unload();
   SoundManager::clear();
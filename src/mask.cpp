@@ -28,7 +28,10 @@ Mask::Mask(const std::vector<Shape> &shapes) noexcept
 {
 }
 
-bool Mask::check_collision(const Mask &other, float inflate) const
+static bool check_shapes_collision(const Shape &this_shape,
+                                   const Vector2 &this_position,
+                                   const Shape &other_shape,
+                                   const Vector2 &other_position)
 {
   const auto get_transformed_circle = [](const Shape &shape, const Vector2 &position)
   {
@@ -51,120 +54,130 @@ bool Mask::check_collision(const Mask &other, float inflate) const
     return Rectangle{ position.x + x, position.y + y, w, h };
   };
 
-  const auto &this_shapes  = shapes;
-  const auto &other_shapes = other.shapes;
+  if (std::holds_alternative<Circle>(this_shape) && std::holds_alternative<Circle>(other_shape))
+  {
+    const auto &this_circle  = get_transformed_circle(this_shape, this_position);
+    const auto &other_circle = get_transformed_circle(other_shape, other_position);
 
-  for (const auto &this_shape : this_shapes)
+    return CheckCollisionCircles(this_circle.center, this_circle.radius, other_circle.center, other_circle.radius);
+  }
+  else if (std::holds_alternative<Rectangle>(this_shape) && std::holds_alternative<Rectangle>(other_shape))
   {
-    auto my_shape = this_shape;
+    const auto &this_rectangle  = get_transformed_rectangle(this_shape, this_position);
+    const auto &other_rectangle = get_transformed_rectangle(other_shape, other_position);
 
-    if (inflate != 0.0f)
-    {
-      const auto inflated_shape = [&]() -> Shape
-      {
-        if (std::holds_alternative<Circle>(this_shape))
-        {
-          const auto &circle = std::get<Circle>(this_shape);
-          return Circle{ circle.center, circle.radius + inflate };
-        }
-        else if (std::holds_alternative<Rectangle>(this_shape))
-        {
-          const auto &rectangle = std::get<Rectangle>(this_shape);
-          return Rectangle{ rectangle.x, rectangle.y, rectangle.width + inflate, rectangle.height + inflate };
-        }
-
-        return this_shape;
-      }();
-      my_shape = inflated_shape;
-    }
+    return CheckCollisionRecs(this_rectangle, other_rectangle);
+  }
+  else if (std::holds_alternative<Circle>(this_shape) && std::holds_alternative<Rectangle>(other_shape))
+  {
+    const auto &this_circle     = get_transformed_circle(this_shape, this_position);
+    const auto &other_rectangle = get_transformed_rectangle(other_shape, other_position);
 
-    for (const auto &other_shape : other_shapes)
-    {
-      if (std::holds_alternative<Circle>(this_shape) && std::holds_alternative<Circle>(other_shape))
-      {
-        const auto &this_circle  = get_transformed_circle(my_shape, position);
-        const auto &other_circle = get_transformed_circle(other_shape, other.position);
-
-        if (CheckCollisionCircles(this_circle.center, this_circle.radius, other_circle.center, other_circle.radius))
-          return true;
-      }
-      else if (std::holds_alternative<Rectangle>(my_shape) && std::holds_alternative<Rectangle>(other_shape))
-      {
-        const auto &this_rectangle  = get_transformed_rectangle(my_shape, position);
-        const auto &other_rectangle = get_transformed_rectangle(other_shape, other.position);
-
-        if (CheckCollisionRecs(this_rectangle, other_rectangle))
-          return true;
-      }
-      else if (std::holds_alternative<Circle>(my_shape) && std::holds_alternative<Rectangle>(other_shape))
-      {
-        const auto &this_circle     = get_transformed_circle(my_shape, position);
-        const auto &other_rectangle = get_transformed_rectangle(other_shape, other.position);
-
-        if (CheckCollisionCircleRec(this_circle.center, this_circle.radius, other_rectangle))
-          return true;
-      }
-      else if (std::holds_alternative<Rectangle>(my_shape) && std::holds_alternative<Circle>(other_shape))
-      {
-        const auto &this_rectangle = get_transformed_rectangle(my_shape, position);
-        const auto &other_circle   = get_transformed_circle(other_shape, other.position);
-
-        if (CheckCollisionCircleRec(other_circle.center, other_circle.radius, this_rectangle))
-          return true;
-      }
-    }
+    return CheckCollisionCircleRec(this_circle.center, this_circle.radius, other_rectangle);
+  }
+  else if (std::holds_alternative<Rectangle>(this_shape) && std::holds_alternative<Circle>(other_shape))
+  {
+    const auto &this_rectangle = get_transformed_rectangle(this_shape, this_position);
+    const auto &other_circle   = get_transformed_circle(other_shape, other_position);
+
+    return CheckCollisionCircleRec(other_circle.center, other_circle.radius, this_rectangle);
   }
 
   return false;
 }
 
-void Mask::draw() const noexcept
+static Shape inflate_shape(const Shape &shape, float inflate)
 {
-  const auto color = [&]() -> Color
+  if (inflate == 0.0f)
+    return shape;
+
+  if (std::holds_alternative<Circle>(shape))
+  {
+    const auto &circle = std::get<Circle>(shape);
+    return Circle{ circle.center, circle.radius + inflate };
+  }
+  else if (std::holds_alternative<Rectangle>(shape))
   {
-    const auto pointer = reinterpret_cast<uintptr_t>(this);
-    int64_t seed       = static_cast<int64_t>(pointer);
-    seed ^= seed << 2;
-    seed ^= seed >> 3;
+    const auto &rectangle = std::get<Rectangle>(shape);
+    return Rectangle{ rectangle.x, rectangle.y, rectangle.width + inflate, rectangle.height + inflate };
+  }
+
+  return shape;
+}
 
-    const auto r = static_cast<uint8_t>((seed & 0xF0) | 0x0F);
-    const auto g = static_cast<uint8_t>(((seed >> 8) & 0xF0) | 0x0F);
-    const auto b = static_cast<uint8_t>(((seed >> 16) & 0xF0) | 0x0F);
-    return Color{ r, g, b, 255 };
-  }();
+bool Mask::check_collision(const Mask &other, float inflate) const
+{
+  for (const auto &other_shape : other.shapes)
+  {
+    if (check_collision(other.position, other_shape, inflate))
+      return true;
+  }
 
+  return false;
+}
+
+bool Mask::check_collision(const Vector2 &other_position, const Shape &other_shape, float inflate) const
+{
+  for (const auto &this_shape : shapes)
+  {
+    if (check_shapes_collision(inflate_shape(this_shape, inflate), position, other_shape, other_position))
+      return true;
+  }
+
+  return false;
+}
+
+void Mask::draw(const Vector2 &at) const noexcept
+{
+  const Color color = debug_color(this);
   for (const auto &shape : shapes)
+    draw_shape(at, shape, color);
+}
+
+Color Mask::debug_color(const void *owner) noexcept
+{
+  const auto pointer = reinterpret_cast<uintptr_t>(owner);
+  int64_t seed       = static_cast<int64_t>(pointer);
+  seed ^= seed << 2;
+  seed ^= seed >> 3;
+
+  const auto r = static_cast<uint8_t>((seed & 0xF0) | 0x0F);
+  const auto g = static_cast<uint8_t>(((seed >> 8) & 0xF0) | 0x0F);
+  const auto b = static_cast<uint8_t>(((seed >> 16) & 0xF0) | 0x0F);
+  return Color{ r, g, b, 255 };
+}
+
+void Mask::draw_shape(const Vector2 &at, const Shape &shape, const Color &color) noexcept
+{
+  if (std::holds_alternative<Circle>(shape))
   {
-    if (std::holds_alternative<Circle>(shape))
-    {
-      const auto &circle = std::get<Circle>(shape);
-      const auto &center = Vector2Add(position, circle.center);
+    const auto &circle = std::get<Circle>(shape);
+    const auto &center = Vector2Add(at, circle.center);
 
-      DrawCircleLinesV(center, circle.radius, color);
+    DrawCircleLinesV(center, circle.radius, color);
 
-      if (GAME.get_state() == GameState::PLAYING_ASTEROIDS)
-      {
-        DrawCircleLinesV(Vector2{ center.x + Game::width, center.y }, circle.radius, color);
-        DrawCircleLinesV(Vector2{ center.x - Game::width, center.y }, circle.radius, color);
-        DrawCircleLinesV(Vector2{ center.x, center.y + Game::height }, circle.radius, color);
-      }
+    if (GAME.get_state() == GameState::PLAYING_ASTEROIDS)
+    {
+      DrawCircleLinesV(Vector2{ center.x + Game::width, center.y }, circle.radius, color);
+      DrawCircleLinesV(Vector2{ center.x - Game::width, center.y }, circle.radius, color);
+      DrawCircleLinesV(Vector2{ center.x, center.y + Game::height }, circle.radius, color);
     }
-    else if (std::holds_alternative<Rectangle>(shape))
+  }
+  else if (std::holds_alternative<Rectangle>(shape))
+  {
+    // Mask rectangle origin is at the center
+    const auto &rectangle = std::get<Rectangle>(shape);
+    int x                 = rectangle.x + at.x - rectangle.width / 2;
+    int y                 = rectangle.y + at.y - rectangle.height / 2;
+    const int w           = rectangle.width;
+    const int h           = rectangle.height;
+
+    DrawRectangleLines(x, y, w, h, color);
+    if (GAME.get_state() == GameState::PLAYING_ASTEROIDS)
     {
-      // Mask rectangle origin is at the center
-      const auto &rectangle = std::get<Rectangle>(shape);
-      int x                 = rectangle.x + position.x - rectangle.width / 2;
-      int y                 = rectangle.y + position.y - rectangle.height / 2;
-      const int w           = rectangle.width;
-      const int h           = rectangle.height;
-
-      DrawRectangleLines(x, y, w, h, color);
-      if (GAME.get_state() == GameState::PLAYING_ASTEROIDS)
-      {
-        DrawRectangleLines(x + Game::width, y, w, h, color);
-        DrawRectangleLines(x - Game::width, y, w, h, color);
-        DrawRectangleLines(x, y + Game::height, w, h, color);
-      }
+      DrawRectangleLines(x + Game::width, y, w, h, color);
+      DrawRectangleLines(x - Game::width, y, w, h, color);
+      DrawRectangleLines(x, y + Game::height, w, h, color);
     }
   }
 }
@@ -30,5 +30,15 @@ struct Mask
   std::vector<Shape> shapes;
 
   [[nodiscard]] bool check_collision(const Mask &other, float inflate = 0.0f) const;
-  void draw() const noexcept;
+  [[nodiscard]] bool check_collision(const Vector2 &other_position,
+                                     const Shape &other_shape,
+                                     float inflate = 0.0f) const;
+  void draw() const noexcept { draw(position); }
+  // draws the shapes at another position, e.g. at a wrapped image of the owner, without copying the mask
+  void draw(const Vector2 &at) const noexcept;
+
+  // draws a single shape, for owners that keep a shape and no mask
+  static void draw_shape(const Vector2 &at, const Shape &shape, const Color &color) noexcept;
+  // color derived from the address of owner, so overlapping masks can be told apart
+  [[nodiscard]] static Color debug_color(const void *owner) noexcept;
 };
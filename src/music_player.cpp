@@ -0,0 +1,247 @@
+#include "music_player.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+
+MusicPlayer::~MusicPlayer()
+{
+#if defined(MUSIC_PLAYER_THREAD)
+  if (thread.joinable())
+  {
+    running.store(false, std::memory_order_release);
+    thread.join();
+  }
+#endif
+
+  for (auto &stream : tracks)
+    close(stream);
+}
+
+MusicPlayer::Track MusicPlayer::load(const std::string &path)
+{
+#if defined(MUSIC_PLAYER_THREAD)
+  assert(!thread.joinable());
+#endif
+
+  const std::string qoa_path = std::filesystem::path(path).replace_extension(".qoa").string();
+
+  tracks.push_back(Stream{ .path = FileExists(qoa_path.c_str()) ? qoa_path : path });
+  return tracks.size() - 1;
+}
+
+void MusicPlayer::start()
+{
+#if defined(MUSIC_PLAYER_THREAD)
+  assert(!thread.joinable());
+  running.store(true, std::memory_order_release);
+  thread = std::thread(&MusicPlayer::run, this);
+  TraceLog(LOG_TRACE, "MusicPlayer: audio thread started with %zu tracks", tracks.size());
+#endif
+}
+
+void MusicPlayer::play(Track track)
+{
+  assert(track < tracks.size());
+  requested_track = track;
+  send(Command{ .type = Command::Type::Play, .track = track });
+}
+
+void MusicPlayer::stop()
+{
+  requested_track = NO_TRACK;
+  send(Command{ .type = Command::Type::Stop });
+}
+
+void MusicPlayer::prefetch(Track track)
+{
+  assert(track < tracks.size());
+  send(Command{ .type = Command::Type::Prefetch, .track = track });
+}
+
+void MusicPlayer::set_volume(float new_volume)
+{
+  send(Command{ .type = Command::Type::SetVolume, .volume = new_volume });
+}
+
+void MusicPlayer::set_buffer_frames(int frames)
+{
+  send(Command{ .type = Command::Type::SetBufferFrames, .buffer_frames = frames });
+}
+
+void MusicPlayer::update()
+{
+#if !defined(MUSIC_PLAYER_THREAD)
+  process_commands();
+  refill();
+#endif
+}
+
+void MusicPlayer::send(const Command &command)
+{
+  while (!commands.push(command))
+  {
+    // NOTE: Only happens when the audio side stalls, waiting keeps play and stop commands from being lost
+#if defined(MUSIC_PLAYER_THREAD)
+    std::this_thread::yield();
+#else
+    process_commands();
+#endif
+  }
+}
+
+void MusicPlayer::process_commands()
+{
+  while (const auto command = commands.pop())
+  {
+    switch (command->type)
+    {
+      case Command::Type::Play:
+      {
+        if (current_track != NO_TRACK && current_track != command->track)
+          close(tracks[current_track]);
+        if (prefetched_track == command->track)
+          prefetched_track = NO_TRACK;
+
+        // NOTE: A prefetched track is already primed, the others are opened and decoded here
+        current_track  = command->track;
+        Stream &stream = tracks[current_track];
+        prime(stream);
+        PlayMusicStream(stream.music);
+        SetMusicVolume(stream.music, volume);
+        stream.primed = false;
+        break;
+      }
+      case Command::Type::Stop:
+        if (current_track != NO_TRACK)
+          close(tracks[current_track]);
+        current_track = NO_TRACK;
+        break;
+      case Command::Type::Prefetch:
+        if (command->track == current_track)
+          break;
+        if (prefetched_track != NO_TRACK && prefetched_track != command->track)
+          close(tracks[prefetched_track]);
+
+        prefetched_track = command->track;
+        prime(tracks[prefetched_track]);
+        break;
+      case Command::Type::SetVolume:
+        volume = command->volume;
+        if (current_track != NO_TRACK)
+          SetMusicVolume(tracks[current_track].music, volume);
+        break;
+      case Command::Type::SetBufferFrames:
+        buffer_frames = command->buffer_frames;
+        if (current_track != NO_TRACK)
+          reload(tracks[current_track]);
+        if (prefetched_track != NO_TRACK)
+          prime(tracks[prefetched_track]);
+        break;
+    }
+  }
+}
+
+void MusicPlayer::refill()
+{
+  if (current_track == NO_TRACK)
+    return;
+
+  Music &music = tracks[current_track].music;
+  if (IsMusicReady(music) && IsMusicStreamPlaying(music))
+    UpdateMusicStream(music);
+}
+
+void MusicPlayer::open(Stream &stream)
+{
+  // NOTE: The stream takes the buffer size set with SetAudioStreamBufferSizeDefault() at load time
+  SetAudioStreamBufferSizeDefault(buffer_frames);
+  stream.music         = LoadMusicStream(stream.path.c_str());
+  stream.buffer_frames = buffer_frames;
+  stream.open          = IsMusicReady(stream.music);
+  stream.primed        = false;
+  TraceLog(LOG_TRACE, "MusicPlayer: opened %s with %d frames", stream.path.c_str(), buffer_frames);
+}
+
+void MusicPlayer::close(Stream &stream)
+{
+  if (!stream.open)
+    return;
+
+  StopMusicStream(stream.music);
+  UnloadMusicStream(stream.music);
+  stream.music  = Music{};
+  stream.open   = false;
+  stream.primed = false;
+}
+
+void MusicPlayer::prime(Stream &stream)
+{
+  if (stream.open && stream.buffer_frames != buffer_frames)
+    close(stream);
+  if (!stream.open)
+    open(stream);
+  if (stream.primed)
+    return;
+
+  // NOTE: Stopping rewinds the decoder and frees both sub buffers, the update then fills them from the start.
+  //       The stream is not playing, so the mixer leaves the decoded frames alone until it is played.
+  StopMusicStream(stream.music);
+  UpdateMusicStream(stream.music);
+  stream.primed = true;
+}
+
+void MusicPlayer::reload(Stream &stream)
+{
+  if (!stream.open || stream.buffer_frames == buffer_frames)
+    return;
+
+  const bool playing   = IsMusicStreamPlaying(stream.music);
+  const float position = playing ? GetMusicTimePlayed(stream.music) : 0.0f;
+
+  close(stream);
+  open(stream);
+
+  if (playing)
+  {
+    PlayMusicStream(stream.music);
+    SeekMusicStream(stream.music, position);
+    SetMusicVolume(stream.music, volume);
+  }
+}
+
+#if defined(MUSIC_PLAYER_THREAD)
+void MusicPlayer::run()
+{
+  while (running.load(std::memory_order_acquire))
+  {
+    process_commands();
+    refill();
+    std::this_thread::sleep_for(std::chrono::milliseconds(REFILL_PERIOD_MS));
+  }
+
+  // NOTE: Applies a last stop sent before shutting down
+  process_commands();
+}
+#endif
+
+void MusicPlaylist::add(MusicPlayer::Track track)
+{
+  tracks.push_back(track);
+  next = tracks[GetRandomValue(0, static_cast<int>(tracks.size()) - 1)];
+}
+
+void MusicPlaylist::clear() noexcept
+{
+  tracks.clear();
+  next = MusicPlayer::NO_TRACK;
+}
+
+MusicPlayer::Track MusicPlaylist::take()
+{
+  assert(!tracks.empty());
+
+  const MusicPlayer::Track track = next;
+  next = tracks[GetRandomValue(0, static_cast<int>(tracks.size()) - 1)];
+  return track;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if !defined(EMSCRIPTEN)
+#include <thread>
+#define MUSIC_PLAYER_THREAD
+#endif
+
+#include <raylib.h>
+
+#include "spsc_queue.hpp"
+
+// NOTE: Owns the music streams and is the only one touching them. Gameplay sends play, stop and volume
+//       commands over a lock-free queue, and an audio thread applies them and refills the playing stream,
+//       so decoding never runs on the simulation thread. Without threads (web builds), update() does it.
+//       Streams are opened when played and closed when stopped or replaced. prefetch() opens the likely
+//       next track ahead and decodes its first buffer, so at most two decoders are resident and a switch
+//       to the prefetched track starts without opening or decoding anything.
+//       Changing the buffer size reloads the playing stream at its position, the others when played next.
+//       QOA decodes much cheaper than MP3 but takes about twice the space at the music bitrate, so the
+//       music ships as MP3 and the QOA versions are only used when converted with the convert_audio target.
+class MusicPlayer
+{
+public:
+  using Track = size_t;
+
+  static constexpr const Track NO_TRACK{ SIZE_MAX };
+  static constexpr const int REFILL_PERIOD_MS{ 5 };
+
+  explicit MusicPlayer(int buffer_frames) : buffer_frames(buffer_frames) {}
+  ~MusicPlayer();
+
+  MusicPlayer(const MusicPlayer &)            = delete;
+  MusicPlayer &operator=(const MusicPlayer &) = delete;
+
+  // registers a track without opening it, only before start(), a .qoa file next to path is preferred
+  [[nodiscard]] Track load(const std::string &path);
+  // starts the audio thread
+  void start();
+
+  // plays track from its start, stopping the current one
+  void play(Track track);
+  void stop();
+  // opens track and decodes its start, replacing the previous prefetch
+  void prefetch(Track track);
+  void set_volume(float volume);
+  // stream buffer size in frames, larger buffers trade latency for fewer underruns
+  void set_buffer_frames(int frames);
+
+  // NOTE: State requested by gameplay, the streams loop so a playing track does not stop on its own
+  [[nodiscard]] bool is_playing() const noexcept { return requested_track != NO_TRACK; }
+  [[nodiscard]] Track get_track() const noexcept { return requested_track; }
+
+  // applies the commands and refills the stream when there is no audio thread, call once per tick
+  void update();
+
+private:
+  struct Command
+  {
+    enum class Type : uint8_t
+    {
+      Play,
+      Stop,
+      Prefetch,
+      SetVolume,
+      SetBufferFrames
+    };
+
+    Type type{ Type::Stop };
+    Track track{ NO_TRACK };
+    float volume{ 1.0f };
+    int buffer_frames{ 0 };
+  };
+
+  struct Stream
+  {
+    Music music{};
+    std::string path;
+    int buffer_frames{ 0 }; // buffer size the music was opened with
+    bool open{ false };
+    bool primed{ false }; // rewound with the first buffer decoded, ready to play
+  };
+
+  void send(const Command &command);
+  // audio side
+  void process_commands();
+  void refill();
+  void open(Stream &stream);
+  void close(Stream &stream);
+  // opens the stream when needed and decodes its start without playing it
+  void prime(Stream &stream);
+  // opens the stream again when the buffer size changed, keeps its position when it was playing
+  void reload(Stream &stream);
+
+  std::vector<Stream> tracks;
+  SpscQueue<Command, 64> commands;
+  Track requested_track{ NO_TRACK };
+
+  // audio side
+  Track current_track{ NO_TRACK };
+  Track prefetched_track{ NO_TRACK };
+  float volume{ 1.0f };
+  int buffer_frames{ 0 };
+
+#if defined(MUSIC_PLAYER_THREAD)
+  void run();
+
+  std::thread thread;
+  std::atomic<bool> running{ false };
+#endif
+};
+
+// NOTE: Random tracks for one kind of level. The next pick is made in advance, so it can be prefetched
+//       while the previous track plays.
+class MusicPlaylist
+{
+public:
+  void add(MusicPlayer::Track track);
+  void clear() noexcept;
+
+  [[nodiscard]] bool empty() const noexcept { return tracks.empty(); }
+  // track returned by the next take()
+  [[nodiscard]] MusicPlayer::Track peek() const noexcept { return next; }
+  // returns peek() and picks the following track
+  [[nodiscard]] MusicPlayer::Track take();
+
+private:
+  std::vector<MusicPlayer::Track> tracks;
+  MusicPlayer::Track next{ MusicPlayer::NO_TRACK };
+};
@@ -30,6 +30,23 @@ struct ObjectCircularBuffer
     }
   }
 
+  // NOTE: Appends count objects returned by make(i) in one go, the oldest objects are overwritten when full
+  void push_n(size_t count, auto make)
+  {
+    count = std::min(count, BUFFER_SIZE - 1);
+
+    const size_t free_slots = BUFFER_SIZE - 1 - size();
+    const size_t first_part = std::min(count, BUFFER_SIZE - head);
+    for (size_t i = 0; i < first_part; i++)
+      objects[head + i] = make(i);
+    for (size_t i = first_part; i < count; i++)
+      objects[i - first_part] = make(i);
+
+    head = (head + count) % BUFFER_SIZE;
+    if (count > free_slots)
+      tail = (tail + count - free_slots) % BUFFER_SIZE;
+  }
+
   constexpr size_t size() const { return head >= tail ? head - tail : BUFFER_SIZE - tail + head; }
 
   constexpr bool empty() const { return head == tail; }
@@ -66,6 +83,22 @@ struct ObjectCircularBuffer
     }
   }
 
+  void for_each(auto func) const
+  {
+    const size_t end = head >= tail ? head : head + BUFFER_SIZE;
+
+    for (size_t i = tail; i < end; i++)
+      func(objects[i % BUFFER_SIZE]);
+  }
+
+  // NOTE: Visits objects [begin, end) counted from the oldest one, without removing any
+  void for_each_in(size_t begin, size_t end, auto func)
+  {
+    end = std::min(end, size());
+    for (size_t i = begin; i < end; i++)
+      func(objects[(tail + i) % BUFFER_SIZE]);
+  }
+
   constexpr void remove(size_t index)
   {
     if (index >= BUFFER_SIZE)
@@ -81,16 +114,15 @@ struct ObjectCircularBuffer
     }
     else
     {
-      if (head > 0)
-      {
-        std::swap(objects[index], objects[head - 1]);
-        head = (head - 1) % BUFFER_SIZE;
-      }
+      const size_t last = head > 0 ? head - 1 : BUFFER_SIZE - 1;
+
+      // NOTE: Trivially copyable objects are plain records, so the removed slot can be overwritten
+      if constexpr (std::is_trivially_copyable_v<T>)
+        objects[index] = objects[last];
       else
-      {
-        std::swap(objects[index], objects[BUFFER_SIZE - 1]);
-        head = BUFFER_SIZE - 1;
-      }
+        std::swap(objects[index], objects[last]);
+
+      head = last;
     }
   }
 };
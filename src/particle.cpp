@@ -19,7 +19,7 @@ Particle Particle::create(const Vector2 &position, const Vector2 &velocity, cons
 
 static const constexpr float asteroid_size_threshold[]{ 100.0f, 400.0f, 1600.0f, 6400.0f };
 
-bool Particle::update() noexcept
+bool Particle::update(uint8_t alpha_decay) noexcept
 {
   position.x += velocity.x;
   position.y += velocity.y;
@@ -28,38 +28,6 @@ bool Particle::update() noexcept
 
   wrap_position(position);
 
-  if (GAME.particles && GAME.particles->capacity > 0 && GAME.frame % 3 == 0)
-  {
-    const auto *first                 = &GAME.particles->objects[0];
-    [[maybe_unused]] const auto *last = &GAME.particles->objects[GAME.particles->capacity];
-    assert(this >= first && this < last);
-
-    const size_t object_id = this - first;
-    if ((GAME.frame % 2 == 0 && object_id % 2 == 0) || (GAME.frame % 2 == 1 && object_id % 2 == 1))
-    {
-      GAME.asteroids->for_each(
-        [&](Asteroid &asteroid)
-        {
-          if (asteroid.size() >= 3)
-            return;
-
-          const Vector2 &asteroid_position = asteroid.position;
-          const float x_diff               = position.x - asteroid_position.x;
-          const float y_diff               = position.y - asteroid_position.y;
-          const float distance_sqr         = x_diff * x_diff + y_diff * y_diff;
-          if (distance_sqr < 25.0f)
-            return;
-
-          if (distance_sqr < asteroid_size_threshold[asteroid.size()])
-          {
-            const float factor = 0.1f / sqrt(distance_sqr);
-            velocity.x += x_diff * factor;
-            velocity.y += y_diff * factor;
-          }
-        });
-    }
-  }
-
   const auto &player             = GAME.player;
   const Vector2 &player_position = player->position;
   const float distance           = Vector2Distance(position, player_position);
@@ -82,7 +50,12 @@ bool Particle::update() noexcept
   }
 
   if (color.a < 255)
-    color.a -= 1;
+  {
+    if (color.a <= alpha_decay)
+      return false;
+
+    color.a -= alpha_decay;
+  }
 
   if (color.a <= 0)
     return false;
@@ -90,9 +63,32 @@ bool Particle::update() noexcept
   return true;
 }
 
-void Particle::draw() const noexcept
+void Particle::apply_asteroid_forces() noexcept
+{
+  GAME.asteroids->rocks.for_each(
+    [&](const Asteroid &asteroid)
+    {
+      const Vector2 &asteroid_position = asteroid.position;
+      const float x_diff               = position.x - asteroid_position.x;
+      const float y_diff               = position.y - asteroid_position.y;
+      const float distance_sqr         = x_diff * x_diff + y_diff * y_diff;
+      if (distance_sqr < 25.0f)
+        return;
+
+      if (distance_sqr < asteroid_size_threshold[asteroid.size()])
+      {
+        const float factor = 0.1f / sqrt(distance_sqr);
+        velocity.x += x_diff * factor;
+        velocity.y += y_diff * factor;
+      }
+    });
+}
+
+void Particle::draw(SoftwareFramebuffer &framebuffer, const Vector2 &origin) const noexcept
 {
   Color c = color;
   c.a     = static_cast<unsigned char>(static_cast<float>(c.a) / 255.0f * 12.0f) * 255 / 12;
-  DrawPixelV(position, c);
+  framebuffer.blend_pixel(static_cast<int>(std::floor(position.x - origin.x)),
+                          static_cast<int>(std::floor(position.y - origin.y)),
+                          c);
 }
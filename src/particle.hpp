@@ -7,6 +7,7 @@
 #include <raymath.h>
 
 #include "object_circular_buffer.hpp"
+#include "software_framebuffer.hpp"
 #include "utils.hpp"
 
 class Particle
@@ -14,8 +15,11 @@ class Particle
 public:
   static Particle create(const Vector2 &position, const Vector2 &velocity, const Color &color) noexcept;
 
-  bool update() noexcept;
-  void draw() const noexcept;
+  bool update(uint8_t alpha_decay = 1) noexcept;
+  // NOTE: Called by the scheduler, every particle is pushed away from asteroids once per pass
+  void apply_asteroid_forces() noexcept;
+  // origin is the world position of the top left pixel of the framebuffer
+  void draw(SoftwareFramebuffer &framebuffer, const Vector2 &origin) const noexcept;
 
   Vector2 position{ 0.0f, 0.0f };
   Vector2 velocity{ 0.0f, 0.0f };
@@ -26,3 +30,5 @@ private:
 
   DECLARE_FRIEND_OBJECT_CIRCULAR_BUFFER()
 };
+
+using ParticleBuffer = ObjectCircularBuffer<Particle, 4096>;
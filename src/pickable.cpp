@@ -1,7 +1,6 @@
 #include "pickable.hpp"
 
-#include <functional>
-
+#include "emitter.hpp"
 #include "game.hpp"
 #include "particle.hpp"
 #include "player.hpp"
@@ -9,44 +8,45 @@
 
 std::unique_ptr<Sprite> Pickable::ORE_SPRITE{};
 
-Pickable Pickable::create(const Vector2 &position, const Vector2 &velocity, const std::function<void()> &func)
+static void ore_effect()
 {
-  if (!ORE_SPRITE)
-    ORE_SPRITE = std::make_unique<Sprite>("resources/ore.aseprite");
-
-  Pickable pickable(position, func);
-  pickable.velocity = velocity;
-  return pickable;
+  GAME.add_crystals(1);
+  GAME.score += 100;
 }
 
-void ore_func()
+static void artifact_effect()
 {
-  GAME.crystals += 1;
-  GAME.score += 100;
+  // TODO: better string building
+  GAME.add_artifact(Artifact{ std::string("Artifact ") + std::to_string(GAME.current_mission) });
 }
 
-Pickable Pickable::create_ore(const Vector2 &position, const Vector2 &velocity)
+// Pick up effects indexed by Pickable::Type
+static void (*const TYPE_EFFECTS[])(){
+  nullptr,
+  ore_effect,
+  artifact_effect,
+};
+
+Pickable Pickable::create(const Vector2 &position, const Vector2 &velocity, Type type)
 {
-  auto pickable = create(position, velocity, ore_func);
-  pickable.type = Type::Ore;
+  if (!ORE_SPRITE)
+    ORE_SPRITE = std::make_unique<Sprite>("resources/ore.aseprite");
+
+  Pickable pickable;
+  pickable.position = position;
+  pickable.velocity = velocity;
+  pickable.type     = type;
   return pickable;
 }
 
-Pickable Pickable::create_artifact(const Vector2 &position, const Vector2 &velocity)
+Pickable Pickable::create_ore(const Vector2 &position, const Vector2 &velocity)
 {
-  // TODO: better string building
-  auto pickable =
-    create(position,
-           velocity,
-           []() { GAME.artifacts.push(Artifact{ std::string("Artifact ") + std::to_string(GAME.current_mission) }); });
-  pickable.type = Type::Artifact;
-  return pickable;
+  return create(position, velocity, Type::Ore);
 }
 
-Pickable::Pickable(const Vector2 &position, const std::function<void()> &func)
-  : position{ position }
-  , func{ func }
+Pickable Pickable::create_artifact(const Vector2 &position, const Vector2 &velocity)
 {
+  return create(position, velocity, Type::Artifact);
 }
 
 bool Pickable::update()
@@ -54,7 +54,7 @@ bool Pickable::update()
   position.x += velocity.x;
   position.y += velocity.y;
 
-  mask.position = position;
+  const Vector2 mask_position = position;
   wrap_position(position);
 
   if (!GAME.player)
@@ -64,7 +64,7 @@ bool Pickable::update()
 
   if (player_id == -1)
   {
-    if (mask.check_collision(player->get_mask()))
+    if (player->get_mask().check_collision(mask_position, SHAPE))
     {
       player_id = 1;
 
@@ -75,15 +75,15 @@ bool Pickable::update()
   }
   else
   {
-    static SMSound sound = SoundManager::get("resources/pickup.wav");
+    static SMSound sound = SoundManager::get("resources/pickup.qoa");
 
     const float player_distance = Vector2Distance(position, player->position);
     if (player_distance < 8.0f)
     {
       sound.play();
 
-      if (func)
-        func();
+      if (const auto effect = TYPE_EFFECTS[static_cast<uint8_t>(type)]; effect)
+        effect();
 
       return false;
     }
@@ -106,7 +106,7 @@ bool Pickable::update()
   {
     if (GAME.frame % 2 == 0)
     {
-      GAME.particles->push(Particle::create(position, Vector2{ 0.0f, 0.0f }, Color{ 10, 255, 255, 200 }));
+      ParticleEmitter::emit(Emitter::ArtifactTrail, position, 1);
 
       velocity.x += static_cast<float>(GetRandomValue(-10, 10)) / 1000.0f;
       velocity.y += static_cast<float>(GetRandomValue(-10, 10)) / 1000.0f;
@@ -116,23 +116,17 @@ bool Pickable::update()
   return true;
 }
 
-void Pickable::draw() const
+void Pickable::draw(RenderQueue &queue) const
 {
   if (type == Type::Ore)
   {
-    if (player_id != -1)
-      ORE_SPRITE->scale = Vector2{ 0.86f, 0.86f };
-    else
-      ORE_SPRITE->scale = Vector2{ 1.0f, 1.0f };
-
-    ORE_SPRITE->set_centered();
-    ORE_SPRITE->position = position;
-    draw_wrapped(ORE_SPRITE->get_destination_rect(),
+    const Sprite &sprite = *ORE_SPRITE;
+    const float scale    = player_id != -1 ? 0.86f : 1.0f;
+
+    draw_wrapped(RenderQueue::sprite_bounds(sprite, position, scale),
+                 GAME.get_drawn_view(),
                  [&](const Vector2 &position)
-                 {
-                   ORE_SPRITE->position = position;
-                   ORE_SPRITE->draw();
-                 });
+                 { queue.push_sprite(RenderLayer::Pickables, sprite, sprite.get_frame(), position, WHITE, scale); });
   }
   else if (type == Type::Artifact)
   {
@@ -143,7 +137,9 @@ void Pickable::draw() const
       pos.y += static_cast<float>(GetRandomValue(-2, 2));
     }
 
-    draw_wrapped(Rectangle{ pos.x - 2.0f, pos.y - 2.0f, 4.0f, 4.0f },
+    // NOTE: The box and the question mark reach up to 10 pixels from the rect position
+    draw_wrapped(Rectangle{ pos.x - 2.0f, pos.y - 2.0f, 20.0f, 20.0f },
+                 GAME.get_drawn_view(),
                  [&](const Vector2 &position)
                  {
                    DrawPixelV(position, WHITE);
@@ -1,8 +1,9 @@
 #pragma once
 
-#include <functional>
+#include <type_traits>
 
 #include "mask.hpp"
+#include "render_queue.hpp"
 #include "sprite.hpp"
 #include "utils.hpp"
 
@@ -18,22 +19,21 @@ public:
     Artifact = 2
   };
 
-  static Pickable create(const Vector2 &position, const Vector2 &velocity, const std::function<void()> &func);
+  static Pickable create(const Vector2 &position, const Vector2 &velocity, Type type);
   static Pickable create_ore(const Vector2 &position, const Vector2 &velocity);
   static Pickable create_artifact(const Vector2 &position, const Vector2 &velocity);
   bool update();
-  void draw() const;
+  void draw(RenderQueue &queue) const;
 
   int8_t player_id : 4 { -1 };
   Type type : 4 { Type::Other };
-  mutable Mask mask{ Circle{ Vector2{ 0.0f, 0.0f }, 24.0f } };
   Vector2 position{ 0.0f, 0.0f };
   Vector2 velocity{ 0.0f, 0.0f };
 
 private:
   Pickable() = default;
-  Pickable(const Vector2 &position, const std::function<void()> &func);
-  std::function<void()> func;
+
+  static constexpr const Circle SHAPE{ Vector2{ 0.0f, 0.0f }, 24.0f };
 
   DECLARE_FRIEND_OBJECT_CIRCULAR_BUFFER()
 
@@ -41,3 +41,5 @@ private:
 
   friend class Game;
 };
+
+static_assert(std::is_trivially_copyable_v<Pickable>);
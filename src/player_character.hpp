@@ -36,5 +36,5 @@ private:
 
   constexpr static float PLAYER_SPEED = 2.0f;
 
-  SMSound sound_step = SoundManager::copy("resources/step.wav");
+  SMSound sound_step = SoundManager::get("resources/step.qoa");
 };
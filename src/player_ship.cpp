@@ -1,6 +1,7 @@
 #include "player_ship.hpp"
 
 #define _USE_MATH_DEFINES
+#include <array>
 #include <cmath>
 #include <functional>
 
@@ -9,9 +10,11 @@
 
 #include "asteroid.hpp"
 #include "bullet.hpp"
+#include "emitter.hpp"
 #include "game.hpp"
 #include "interactable.hpp"
 #include "particle.hpp"
+#include "targeting.hpp"
 #include "utils.hpp"
 
 PlayerShip::PlayerShip()
@@ -36,22 +39,37 @@ void PlayerShip::draw() const noexcept
 
   sprite.position = position;
 
-  draw_wrapped(sprite.get_destination_rect(),
+  // NOTE: The ship rotates around its position, its bounds cover every rotation
+  const Rectangle destination = sprite.get_destination_rect();
+  const Rectangle bounds      = sprite.get_bounds();
+  draw_wrapped(Rectangle{ destination.x, destination.y, bounds.width, bounds.height },
+               GAME.get_drawn_view(),
                [&](const Vector2 &P)
                {
                  sprite.position = P;
                  sprite.draw();
 
                  if (CONFIG(show_masks))
-                 {
-                   Mask mask_copy     = mask;
-                   mask_copy.position = P;
-                   mask_copy.draw();
-                 }
+                   mask.draw(P);
 
                  if (CONFIG(show_velocity))
                    DrawLineEx(P, Vector2{ P.x + velocity.x * 10.0f, P.y + velocity.y * 10.0f }, 1.0f, RED);
                });
+
+#if defined(DEBUG)
+  // NOTE: Closest targets the assisted and homing guns pick from
+  if (CONFIG(debug_bullets))
+  {
+    std::array<const Target *, 3> nearest_targets{};
+    const size_t found = GAME.targets->nearest_k(position, nearest_targets);
+    for (size_t i = 0; i < found; i++)
+    {
+      const Vector2 target_position =
+        Vector2Add(position, TargetIndex::wrapped_delta(position, nearest_targets[i]->position));
+      DrawLineEx(position, target_position, 1.0f, i == 0 ? RED : ORANGE);
+    }
+  }
+#endif
 }
 
 void PlayerShip::die()
@@ -60,24 +78,8 @@ void PlayerShip::die()
 
   sound_explode.play();
 
-  for (int i = 0; i < 10; ++i)
-  {
-    const Vector2 pos{ position.x + static_cast<float>(GetRandomValue(-20, 20)),
-                       position.y + static_cast<float>(GetRandomValue(-20, 20)) };
-    const Vector2 vel = Vector2Normalize(
-      Vector2{ static_cast<float>(GetRandomValue(-100, 100)), static_cast<float>(GetRandomValue(-100, 100)) });
-    const Color color = ColorBrightness(BLACK, 0.1f);
-    game.particles->push(Particle::create(pos, vel, color));
-  }
-  for (int i = 0; i < 100; ++i)
-  {
-    const Vector2 pos{ position.x + static_cast<float>(GetRandomValue(-10, 10)),
-                       position.y + static_cast<float>(GetRandomValue(-10, 10)) };
-    const Vector2 vel = Vector2Normalize(
-      Vector2{ static_cast<float>(GetRandomValue(-100, 100)), static_cast<float>(GetRandomValue(-100, 100)) });
-    const Color color{ 250, 200, 120, 240 };
-    game.particles->push(Particle::create(pos, vel, color));
-  }
+  ParticleEmitter::emit(Emitter::ShipDebris, position, 10);
+  ParticleEmitter::emit(Emitter::ShipExplosion, position, 100);
 
   lives--;
   position.x = Game::width / 2.0f;
@@ -100,7 +102,7 @@ void PlayerShip::die()
 
     if (game.crystals >= r)
     {
-      game.crystals -= r;
+      game.spend_crystals(r);
       game.gui->show_message("You have died! You lost " + std::to_string(r) + " crystals.");
     }
     else
@@ -155,18 +157,12 @@ void PlayerShip::shoot() noexcept
   if (bullet_type == BulletType::Normal)
   {
     game.bullets->push(Bullet::create_normal(bullet_position, bullet_velocity));
-    for (int i = 0; i < 4; ++i)
-    {
-      const Vector2 pos{
-        static_cast<float>(position.x + cos(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 10.0f + GetRandomValue(-2, 2)),
-        static_cast<float>(position.y + sin(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 10.0f + GetRandomValue(-2, 2))
-      };
-      Color color = PINK;
-      color.a     = 120;
-      game.particles->push(Particle::create(pos, Vector2Scale(bullet_velocity, 0.99f), color));
-      color.a = 20;
-      game.particles->push(Particle::create(pos, Vector2Scale(bullet_velocity, 0.2f), color));
-    }
+    const Vector2 nozzle_position{
+      static_cast<float>(position.x + cos(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 10.0f),
+      static_cast<float>(position.y + sin(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 10.0f)
+    };
+    ParticleEmitter::emit(Emitter::MuzzleFlash, nozzle_position, 4, bullet_velocity);
+    ParticleEmitter::emit(Emitter::MuzzleGlow, nozzle_position, 4, bullet_velocity);
   }
   else if (bullet_type == BulletType::Homing)
   {
@@ -222,24 +218,12 @@ void PlayerShip::handle_input()
 
     sprite.set_tag("fly");
 
-    for (int i = 0; i < 1; ++i)
-    {
-      const Vector2 pos{
-        static_cast<float>(position.x + cos(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 10.0f + GetRandomValue(-2, 2)),
-        static_cast<float>(position.y + sin(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 10.0f + GetRandomValue(-2, 2))
-      };
-      Vector2 vel{ static_cast<float>(cos(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 2.0f),
-                   static_cast<float>(sin(sprite.rotation * DEG2RAD + M_PI / 2.0f) * 2.0f) };
-      Color color = WHITE;
-      color.a     = 40;
-      game.particles->push(Particle::create(pos, vel, color));
-
-      vel.x *= 0.5f;
-      vel.y *= 0.5f;
-      color   = BROWN;
-      color.a = 80;
-      game.particles->push(Particle::create(pos, vel, color));
-    }
+    const Vector2 exhaust_direction{ static_cast<float>(cos(sprite.rotation * DEG2RAD + M_PI / 2.0f)),
+                                     static_cast<float>(sin(sprite.rotation * DEG2RAD + M_PI / 2.0f)) };
+    const Vector2 nozzle_position  = Vector2Add(position, Vector2Scale(exhaust_direction, 10.0f));
+    const Vector2 exhaust_velocity = Vector2Scale(exhaust_direction, 2.0f);
+    ParticleEmitter::emit(Emitter::EngineExhaust, nozzle_position, 1, exhaust_velocity);
+    ParticleEmitter::emit(Emitter::EngineSmoke, nozzle_position, 1, exhaust_velocity);
   }
   else
   {
@@ -314,7 +298,7 @@ void PlayerShip::update()
     GAME.asteroids->for_each(
       [&](Asteroid &asteroid) -> void
       {
-        if (asteroid.mask.check_collision(mask))
+        if (asteroid.check_collision(mask))
         {
           die();
           return;
@@ -51,7 +51,7 @@ private:
 
   bool can_shoot() const noexcept;
 
-  SMSound sound_shoot{ SoundManager::get("resources/shoot.wav") };
-  SMSound sound_engine{ SoundManager::copy("resources/engine.wav") };
-  SMSound sound_explode{ SoundManager::copy("resources/explosion.wav") };
+  SMSound sound_shoot{ SoundManager::get("resources/shoot.qoa") };
+  SMSound sound_engine{ SoundManager::get("resources/engine.qoa") };
+  SMSound sound_explode{ SoundManager::get("resources/explosion.qoa") };
 };
@@ -0,0 +1,347 @@
+#include "profiler.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <rlgl.h>
+
+RenderCounters &RenderCounters::operator+=(const RenderCounters &other) noexcept
+{
+  draw_calls += other.draw_calls;
+  batch_flushes += other.batch_flushes;
+  texture_switches += other.texture_switches;
+  vertices += other.vertices;
+  framebuffer_switches += other.framebuffer_switches;
+  return *this;
+}
+
+RenderCounters RenderCounters::operator-(const RenderCounters &other) const noexcept
+{
+  return RenderCounters{ .draw_calls           = draw_calls - other.draw_calls,
+                         .batch_flushes        = batch_flushes - other.batch_flushes,
+                         .texture_switches     = texture_switches - other.texture_switches,
+                         .vertices             = vertices - other.vertices,
+                         .framebuffer_switches = framebuffer_switches - other.framebuffer_switches };
+}
+
+RenderCounters RenderCounters::read() noexcept
+{
+  const rlRenderStats stats = rlGetRenderStats();
+  return RenderCounters{ .draw_calls           = stats.drawCalls,
+                         .batch_flushes        = stats.batchFlushes,
+                         .texture_switches     = stats.textureSwitches,
+                         .vertices             = stats.vertexCount,
+                         .framebuffer_switches = stats.framebufferSwitches };
+}
+
+ProfileCounters &ProfileCounters::operator+=(const ProfileCounters &other) noexcept
+{
+  render += other.render;
+  heap += other.heap;
+  return *this;
+}
+
+ProfileCounters ProfileCounters::operator-(const ProfileCounters &other) const noexcept
+{
+  return ProfileCounters{ .render = render - other.render, .heap = heap - other.heap };
+}
+
+ProfileCounters ProfileCounters::read() noexcept
+{
+  return ProfileCounters{ .render = RenderCounters::read(), .heap = AllocationCounters::read() };
+}
+
+Profiler::Scope::Scope(Profiler &profiler, const char *name)
+  : profiler(profiler)
+{
+  profiler.begin_section(name);
+}
+
+Profiler::Scope::~Scope()
+{
+  profiler.end_section();
+}
+
+void Profiler::begin_frame() noexcept
+{
+  assert(stack.empty());
+
+  // NOTE: The rlgl counters are only reset here, so they do not overflow between two frames
+  rlResetRenderStats();
+  frame_start = ProfileCounters::read();
+
+  for (auto &section : sections)
+  {
+    section.current     = ProfileCounters{};
+    section.over_budget = false;
+  }
+}
+
+void Profiler::end_frame() noexcept
+{
+  assert(stack.empty());
+
+  // NOTE: Flushes the last draws of the frame now, EndDrawing would do it after the frame is closed
+  rlDrawRenderBatchActive();
+  last_frame = ProfileCounters::read() - frame_start;
+  total_frames += last_frame;
+  frame_count++;
+
+  for (auto &section : sections)
+  {
+    section.last = section.current;
+    section.total += section.current;
+  }
+}
+
+void Profiler::begin_section(const char *name)
+{
+  if (flush_sections)
+    rlDrawRenderBatchActive();
+
+  const size_t parent = stack.empty() ? NO_PARENT : stack.back().index;
+  const size_t index  = find_section(name, parent);
+
+  // NOTE: Read last, so the allocations of the profiler itself are not counted by the new section
+  stack.push_back(OpenSection{ .index = index });
+  stack.back().start = ProfileCounters::read();
+}
+
+void Profiler::end_section() noexcept
+{
+  assert(!stack.empty());
+
+  if (flush_sections)
+    rlDrawRenderBatchActive();
+
+  const OpenSection &open = stack.back();
+  Section &section        = sections[open.index];
+  section.current += ProfileCounters::read() - open.start;
+  stack.pop_back();
+
+  check_budget(section);
+}
+
+void Profiler::set_allocation_budget(const std::string &path, uint64_t max_allocations, BudgetAction action)
+{
+  size_t budget = find_budget(path);
+  if (budget == NO_BUDGET)
+  {
+    budget = budgets.size();
+    budgets.push_back(AllocationBudget{ .path = path });
+  }
+
+  budgets[budget].max_allocations = max_allocations;
+  budgets[budget].action          = action;
+
+  for (size_t i = 0; i < sections.size(); i++)
+  {
+    if (get_path(i) == path)
+      sections[i].budget = budget;
+  }
+
+  if constexpr (!ALLOCATION_TRACKING)
+    TraceLog(LOG_DEBUG, "Profiler: allocation budget for \"%s\" set without TRACK_ALLOCATIONS", path.c_str());
+}
+
+size_t Profiler::find_budget(const std::string &path) const noexcept
+{
+  for (size_t i = 0; i < budgets.size(); i++)
+  {
+    if (budgets[i].path == path)
+      return i;
+  }
+
+  return NO_BUDGET;
+}
+
+void Profiler::check_budget(Section &section)
+{
+  if (section.budget == NO_BUDGET || section.over_budget)
+    return;
+
+  AllocationBudget &budget = budgets[section.budget];
+  if (section.current.heap.allocations <= budget.max_allocations)
+    return;
+
+  // NOTE: Reported once per frame, when the section goes over, and the log is throttled for hot sections
+  section.over_budget = true;
+  if (budget.exceeded_frames++ % BUDGET_LOG_PERIOD == 0)
+  {
+    TraceLog(LOG_WARNING,
+             "Profiler: \"%s\" made %llu allocations (%llu bytes) in a frame, its budget is %llu (exceeded %llu times)",
+             budget.path.c_str(),
+             static_cast<unsigned long long>(section.current.heap.allocations),
+             static_cast<unsigned long long>(section.current.heap.bytes),
+             static_cast<unsigned long long>(budget.max_allocations),
+             static_cast<unsigned long long>(budget.exceeded_frames));
+  }
+
+  assert(budget.action != BudgetAction::Assert && "allocation budget exceeded");
+}
+
+size_t Profiler::find_section(const char *name, size_t parent)
+{
+  // NOTE: A new section is inserted after the last descendant of its parent, so the list stays in tree order
+  size_t position = parent == NO_PARENT ? 0 : parent + 1;
+  for (; position < sections.size(); position++)
+  {
+    const Section &section = sections[position];
+    if (parent != NO_PARENT && section.depth <= sections[parent].depth)
+      break;
+    if (section.parent == parent && std::strcmp(section.name, name) == 0)
+      return position;
+  }
+
+  // NOTE: Open sections are ancestors of the new one and stay before it
+  for (auto &section : sections)
+  {
+    if (section.parent != NO_PARENT && section.parent >= position)
+      section.parent++;
+  }
+
+  const size_t depth = parent == NO_PARENT ? 0 : sections[parent].depth + 1;
+  sections.insert(sections.begin() + static_cast<std::ptrdiff_t>(position),
+                  Section{ .name = name, .parent = parent, .depth = depth });
+  if (!budgets.empty())
+    sections[position].budget = find_budget(get_path(position));
+  return position;
+}
+
+std::string Profiler::get_path(size_t index) const
+{
+  std::string path = sections[index].name;
+  for (size_t parent = sections[index].parent; parent != NO_PARENT; parent = sections[parent].parent)
+    path = std::string(sections[parent].name) + "/" + path;
+
+  return path;
+}
+
+void Profiler::draw_debug() const noexcept
+{
+  const int font_size = 10;
+  const int x         = 260;
+  int y               = 80;
+
+  DrawText(TextFormat("%-20s %6s %6s %6s %7s %4s%s",
+                      "section",
+                      "draws",
+                      "flush",
+                      "tex",
+                      "verts",
+                      "fbo",
+                      ALLOCATION_TRACKING ? "  allocs  bytes" : ""),
+           x,
+           y,
+           font_size,
+           GOLD);
+  y += font_size + 2;
+
+  auto draw_row = [&](const char *name, size_t depth, const ProfileCounters &counters, bool over_budget)
+  {
+    const std::string label      = std::string(depth * 2, ' ') + name;
+    const RenderCounters &render = counters.render;
+
+    std::string heap;
+    if (ALLOCATION_TRACKING)
+    {
+      heap = TextFormat(" %7llu %6llu",
+                        static_cast<unsigned long long>(counters.heap.allocations),
+                        static_cast<unsigned long long>(counters.heap.bytes));
+    }
+
+    DrawText(TextFormat("%-20s %6llu %6llu %6llu %7llu %4llu%s",
+                        label.c_str(),
+                        static_cast<unsigned long long>(render.draw_calls),
+                        static_cast<unsigned long long>(render.batch_flushes),
+                        static_cast<unsigned long long>(render.texture_switches),
+                        static_cast<unsigned long long>(render.vertices),
+                        static_cast<unsigned long long>(render.framebuffer_switches),
+                        heap.c_str()),
+             x,
+             y,
+             font_size,
+             over_budget ? RED : GOLD);
+    y += font_size + 2;
+  };
+
+  draw_row(flush_sections ? "frame (flushed)" : "frame", 0, last_frame, false);
+  for (const auto &section : sections)
+    draw_row(section.name, section.depth + 1, section.last, section.budget != NO_BUDGET && section.over_budget);
+}
+
+bool Profiler::write_json(const std::string &path) const
+{
+  auto to_json = [](const ProfileCounters &counters)
+  {
+    const RenderCounters &render = counters.render;
+    nlohmann::json json{ { "draw_calls", render.draw_calls },
+                         { "batch_flushes", render.batch_flushes },
+                         { "texture_switches", render.texture_switches },
+                         { "vertices", render.vertices },
+                         { "framebuffer_switches", render.framebuffer_switches } };
+    if (ALLOCATION_TRACKING)
+    {
+      json["allocations"]     = counters.heap.allocations;
+      json["allocated_bytes"] = counters.heap.bytes;
+      json["frees"]           = counters.heap.frees;
+    }
+    return json;
+  };
+
+  auto to_average_json = [this](const ProfileCounters &counters)
+  {
+    const double frames          = frame_count > 0 ? static_cast<double>(frame_count) : 1.0;
+    const RenderCounters &render = counters.render;
+    nlohmann::json json{ { "draw_calls", static_cast<double>(render.draw_calls) / frames },
+                         { "batch_flushes", static_cast<double>(render.batch_flushes) / frames },
+                         { "texture_switches", static_cast<double>(render.texture_switches) / frames },
+                         { "vertices", static_cast<double>(render.vertices) / frames },
+                         { "framebuffer_switches", static_cast<double>(render.framebuffer_switches) / frames } };
+    if (ALLOCATION_TRACKING)
+    {
+      json["allocations"]     = static_cast<double>(counters.heap.allocations) / frames;
+      json["allocated_bytes"] = static_cast<double>(counters.heap.bytes) / frames;
+      json["frees"]           = static_cast<double>(counters.heap.frees) / frames;
+    }
+    return json;
+  };
+
+  nlohmann::json json;
+  json["frames"]         = frame_count;
+  json["flush_sections"] = flush_sections;
+  json["last_frame"]     = to_json(last_frame);
+  json["average_frame"]  = to_average_json(total_frames);
+  json["sections"]       = nlohmann::json::array();
+
+  for (size_t i = 0; i < sections.size(); i++)
+  {
+    json["sections"].push_back({ { "path", get_path(i) },
+                                 { "last_frame", to_json(sections[i].last) },
+                                 { "average_frame", to_average_json(sections[i].total) } });
+  }
+
+  for (const auto &[name, export_function] : exports)
+    json[name] = export_function();
+
+  std::ofstream file(path);
+  if (!file)
+  {
+    TraceLog(LOG_WARNING, "Profiler: cannot write \"%s\"", path.c_str());
+    return false;
+  }
+
+  file << json.dump(2);
+  TraceLog(LOG_INFO,
+           "Profiler: %llu frames written to \"%s\"",
+           static_cast<unsigned long long>(frame_count),
+           path.c_str());
+  return true;
+}
+
+void Profiler::add_export(const std::string &name, std::function<nlohmann::json()> &&export_function)
+{
+  exports.emplace_back(name, std::move(export_function));
+}
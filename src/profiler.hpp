@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+#include <raylib.h>
+
+#include "allocation_tracker.hpp"
+
+struct RenderCounters
+{
+  uint64_t draw_calls{ 0 };
+  uint64_t batch_flushes{ 0 };
+  uint64_t texture_switches{ 0 };
+  uint64_t vertices{ 0 };
+  uint64_t framebuffer_switches{ 0 };
+
+  RenderCounters &operator+=(const RenderCounters &other) noexcept;
+  [[nodiscard]] RenderCounters operator-(const RenderCounters &other) const noexcept;
+
+  // current value of the rlgl counters
+  [[nodiscard]] static RenderCounters read() noexcept;
+};
+
+struct ProfileCounters
+{
+  RenderCounters render;
+  AllocationCounters heap; // of the main thread
+
+  ProfileCounters &operator+=(const ProfileCounters &other) noexcept;
+  [[nodiscard]] ProfileCounters operator-(const ProfileCounters &other) const noexcept;
+
+  [[nodiscard]] static ProfileCounters read() noexcept;
+};
+
+// NOTE: Attributes the rlgl submission counters to named, nested sections of a frame. rlgl batches draws,
+//       so draw calls and vertices are counted by the section that flushes the batch. With flush_sections
+//       the batch is flushed at every section boundary, which gives exact numbers per section at the cost
+//       of extra flushes. Heap allocations are attributed the same way when built with TRACK_ALLOCATIONS, and
+//       a section can get an allocation budget per frame, exceeding it is logged or asserted.
+class Profiler
+{
+public:
+  enum class BudgetAction : uint8_t
+  {
+    Log,
+    Assert
+  };
+
+  class Scope
+  {
+  public:
+    Scope(Profiler &profiler, const char *name);
+    ~Scope();
+
+    Scope(const Scope &)            = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    Profiler &profiler;
+  };
+
+  void begin_frame() noexcept;
+  void end_frame() noexcept;
+
+  // section names have to outlive the profiler, a section entered twice in a frame is accumulated
+  [[nodiscard]] Scope scope(const char *name) { return Scope(*this, name); }
+  void begin_section(const char *name);
+  void end_section() noexcept;
+
+  void set_flush_sections(bool flush) noexcept { flush_sections = flush; }
+  [[nodiscard]] bool get_flush_sections() const noexcept { return flush_sections; }
+
+  [[nodiscard]] const ProfileCounters &get_frame() const noexcept { return last_frame; }
+
+  // path is the section names from the root separated by '/', e.g. "update/asteroids"
+  void set_allocation_budget(const std::string &path, uint64_t max_allocations, BudgetAction action);
+
+  void draw_debug() const noexcept;
+  // writes the last frame and the per frame averages since the start as json
+  bool write_json(const std::string &path) const;
+  // adds the stats of another system to write_json, under name
+  void add_export(const std::string &name, std::function<nlohmann::json()> &&export_function);
+
+private:
+  struct Section
+  {
+    const char *name{ nullptr };
+    size_t parent{ NO_PARENT };
+    size_t depth{ 0 };
+    ProfileCounters current;
+    ProfileCounters last;
+    ProfileCounters total;
+    size_t budget{ NO_BUDGET };
+    bool over_budget{ false }; // reported in the current frame
+  };
+
+  struct OpenSection
+  {
+    size_t index{ 0 };
+    ProfileCounters start;
+  };
+
+  struct AllocationBudget
+  {
+    std::string path;
+    uint64_t max_allocations{ 0 };
+    BudgetAction action{ BudgetAction::Log };
+    uint64_t exceeded_frames{ 0 };
+  };
+
+  static constexpr const size_t NO_PARENT{ SIZE_MAX };
+  static constexpr const size_t NO_BUDGET{ SIZE_MAX };
+  static constexpr const uint64_t BUDGET_LOG_PERIOD{ 60 }; // frames between two logs of the same budget
+
+  [[nodiscard]] size_t find_section(const char *name, size_t parent);
+  [[nodiscard]] std::string get_path(size_t index) const;
+  [[nodiscard]] size_t find_budget(const std::string &path) const noexcept;
+  void check_budget(Section &section);
+
+  std::vector<Section> sections; // in the order they were first entered, parents before children
+  std::vector<OpenSection> stack;
+  std::vector<AllocationBudget> budgets;
+  ProfileCounters frame_start;
+  ProfileCounters last_frame;
+  ProfileCounters total_frames;
+  uint64_t frame_count{ 0 };
+  bool flush_sections{ false };
+  std::vector<std::pair<std::string, std::function<nlohmann::json()>>> exports;
+};
@@ -0,0 +1,48 @@
+#include "quality_governor.hpp"
+
+#include <raylib.h>
+
+static constexpr const float COST_SMOOTHING{ 0.1f };
+static constexpr const float HEADROOM_RATIO{ 0.6f };
+static constexpr const uint32_t FRAMES_TO_DECREASE{ 10 };
+static constexpr const uint32_t FRAMES_TO_INCREASE{ 180 };
+
+void QualityGovernor::report_frame(float update_ms, float render_ms) noexcept
+{
+  frame_cost_ms += (update_ms + render_ms - frame_cost_ms) * COST_SMOOTHING;
+
+  if (frame_cost_ms > TARGET_FRAME_MS)
+  {
+    frames_under_budget = 0;
+    if (++frames_over_budget >= FRAMES_TO_DECREASE && level > 0)
+    {
+      level--;
+      frames_over_budget = 0;
+      TraceLog(LOG_DEBUG, "Quality lowered to %zu (frame cost %.2fms)", level, frame_cost_ms);
+    }
+  }
+  else if (frame_cost_ms < TARGET_FRAME_MS * HEADROOM_RATIO)
+  {
+    frames_over_budget = 0;
+    if (++frames_under_budget >= FRAMES_TO_INCREASE && level < get_max_level())
+    {
+      level++;
+      frames_under_budget = 0;
+      TraceLog(LOG_DEBUG, "Quality raised to %zu (frame cost %.2fms)", level, frame_cost_ms);
+    }
+  }
+  else
+  {
+    frames_over_budget  = 0;
+    frames_under_budget = 0;
+  }
+}
+
+void QualityGovernor::draw_debug() const noexcept
+{
+  DrawText(TextFormat("Quality: %zu/%zu (%.2fms of %.2fms)", level, get_max_level(), frame_cost_ms, TARGET_FRAME_MS),
+           40,
+           40,
+           10,
+           GOLD);
+}
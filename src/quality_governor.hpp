@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+struct QualitySettings
+{
+  float particle_spawn_rate{ 1.0f };    // emitted particle counts are multiplied by this
+  uint8_t particle_alpha_decay{ 1 };    // alpha lost by a fading particle every tick
+  float background_density{ 1.0f };     // fraction of background asteroid tiles drawn
+  uint32_t particle_forces_period{ 6 }; // ticks between two particle-asteroid interaction passes
+};
+
+// NOTE: Watches the measured update+render time of every frame and steps the quality level down
+//       quickly when it stays over the budget, and back up slowly once there is enough headroom.
+class QualityGovernor
+{
+public:
+  static constexpr const float TARGET_FRAME_MS{ 1000.0f / 60.0f * 0.75f };
+
+  void report_frame(float update_ms, float render_ms) noexcept;
+
+  [[nodiscard]] const QualitySettings &settings() const noexcept { return LEVELS[level]; }
+  [[nodiscard]] size_t get_level() const noexcept { return level; }
+  [[nodiscard]] size_t get_max_level() const noexcept { return LEVELS.size() - 1; }
+  [[nodiscard]] float get_frame_cost_ms() const noexcept { return frame_cost_ms; }
+
+  void draw_debug() const noexcept;
+
+private:
+  static constexpr const std::array<QualitySettings, 5> LEVELS{
+    QualitySettings{ 0.25f, 4, 0.2f, 24 }, QualitySettings{ 0.35f, 3, 0.35f, 18 },
+    QualitySettings{ 0.5f, 2, 0.5f, 12 },  QualitySettings{ 0.75f, 1, 0.75f, 8 },
+    QualitySettings{ 1.0f, 1, 1.0f, 6 },
+  };
+
+  size_t level{ LEVELS.size() - 1 };
+  float frame_cost_ms{ 0.0f };
+  uint32_t frames_over_budget{ 0 };
+  uint32_t frames_under_budget{ 0 };
+};
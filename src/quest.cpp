@@ -3,11 +3,20 @@
 #include "game.hpp"
 
 SMSound Quest::sound_complete;
+uint64_t Quest::revision{ 0 };
+
+void Quest::accept() noexcept
+{
+  if (!accepted)
+    revision++;
+
+  accepted = true;
+}
 
 void Quest::report() noexcept
 {
   if (!sound_complete.is_loaded())
-    sound_complete = SoundManager::get("resources/tada.wav");
+    sound_complete = SoundManager::get("resources/tada.qoa");
 
   sound_complete.play();
 
@@ -20,5 +29,19 @@ void Quest::report() noexcept
 
     GAME.gui->show_message("Quest completed!");
     reported = true;
+    revision++;
   }
 }
+
+void Quest::on_event(const GameEvent &event)
+{
+  if (reported || !advance)
+    return;
+
+  const size_t new_progress = advance(event, progress);
+  if (new_progress == progress)
+    return;
+
+  progress = new_progress;
+  revision++;
+}
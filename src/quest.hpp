@@ -1,29 +1,45 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
+#include "event_bus.hpp"
 #include "sound_manager.hpp"
 
+// NOTE: Progress is only updated by the events of one type, published on the game event bus, instead of
+//       being queried every frame. Events are counted before the quest is accepted too, like progress made
+//       before talking to the quest giver.
 struct Quest
 {
   std::string description{};
-  std::function<size_t()> progress;
-  std::function<size_t()> max_progress;
+  GameEvent::Type event{ GameEvent::Type::CrystalsChanged };
+  // progress after event, given the current one
+  std::function<size_t(const GameEvent &event, size_t progress)> advance;
+  size_t max_progress{ 1 };
   std::function<void()> on_report;
 
   [[nodiscard]] bool is_accepted() const noexcept { return accepted; }
-  void accept() noexcept { accepted = true; }
+  void accept() noexcept;
 
-  [[nodiscard]] bool is_completed() const noexcept { return reported || progress() >= max_progress(); }
+  [[nodiscard]] size_t get_progress() const noexcept { return progress; }
+  [[nodiscard]] bool is_completed() const noexcept { return reported || progress >= max_progress; }
 
   [[nodiscard]] bool is_reported() const noexcept { return reported; }
   void report() noexcept;
 
+  // subscribed to event on the bus
+  void on_event(const GameEvent &event);
+
   bool accepted{ false };
   bool reported{ false };
 
+  size_t progress{ 0 };
+
   size_t score{ 12000 };
 
   static SMSound sound_complete;
+  // NOTE: Changes whenever the progress, acceptance or report of any quest changed, the HUD is only
+  //       redrawn then
+  static uint64_t revision;
 };
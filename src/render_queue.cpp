@@ -0,0 +1,74 @@
+#include "render_queue.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "sprite.hpp"
+
+void RenderQueue::push_sprite(RenderLayer layer,
+                              const Sprite &sprite,
+                              int frame,
+                              const Vector2 &position,
+                              const Color &tint,
+                              float scale)
+{
+  const Texture2D &texture = sprite.get_texture();
+  const Rectangle bounds   = sprite_bounds(sprite, position, scale);
+
+  commands.push_back(Command{ .key         = make_key(layer, texture.id),
+                              .kind        = Kind::Sprite,
+                              .texture     = texture,
+                              .source      = sprite.get_frame_rect(frame),
+                              .destination = bounds,
+                              .origin      = Vector2{ std::floor(bounds.width / 2.0f), std::floor(bounds.height / 2.0f) },
+                              .tint        = tint });
+}
+
+void RenderQueue::push_circle(RenderLayer layer, const Vector2 &center, float radius, const Color &color)
+{
+  // NOTE: Shapes are drawn with the default texture, so they sort before the sprites of the same layer
+  commands.push_back(Command{ .key         = make_key(layer, 0),
+                              .kind        = Kind::Circle,
+                              .destination = Rectangle{ center.x, center.y, radius, radius },
+                              .tint        = color });
+}
+
+void RenderQueue::submit()
+{
+  std::sort(commands.begin(),
+            commands.end(),
+            [](const Command &a, const Command &b) { return a.key < b.key; });
+
+  for (const auto &command : commands)
+  {
+    switch (command.kind)
+    {
+      case Kind::Sprite:
+        DrawTexturePro(command.texture, command.source, command.destination, command.origin, 0.0f, command.tint);
+        break;
+      case Kind::Circle:
+        DrawCircleV(Vector2{ command.destination.x, command.destination.y }, command.destination.width, command.tint);
+        break;
+    }
+  }
+
+  commands.clear();
+}
+
+Rectangle RenderQueue::sprite_bounds(const Sprite &sprite, const Vector2 &position, float scale)
+{
+  return Rectangle{ std::roundf(position.x),
+                    std::roundf(position.y),
+                    static_cast<float>(sprite.get_width()) * scale,
+                    static_cast<float>(sprite.get_height()) * scale };
+}
+
+uint64_t RenderQueue::make_key(RenderLayer layer, unsigned int texture_id) const noexcept
+{
+  assert(texture_id < (1u << 24));
+  assert(commands.size() < (size_t{ 1 } << 32));
+
+  return (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(texture_id) << 32) |
+         static_cast<uint64_t>(commands.size());
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+class Sprite;
+
+// NOTE: Layers are submitted in declaration order
+enum class RenderLayer : uint8_t
+{
+  Projectiles,
+  Asteroids,
+  AlienProjectiles,
+  Pickables,
+};
+
+// NOTE: Entities record what they want drawn instead of drawing it. On submit the commands are sorted by
+//       layer and then by texture, so every texture and primitive change happens once per layer and rlgl
+//       can keep batching, and shared sprites are only read while the commands are recorded.
+class RenderQueue
+{
+public:
+  // draws a frame of the sprite centered on position
+  void push_sprite(RenderLayer layer,
+                   const Sprite &sprite,
+                   int frame,
+                   const Vector2 &position,
+                   const Color &tint,
+                   float scale = 1.0f);
+  void push_circle(RenderLayer layer, const Vector2 &center, float radius, const Color &color);
+
+  // draws and removes all the recorded commands
+  void submit();
+
+  [[nodiscard]] size_t size() const noexcept { return commands.size(); }
+
+  // bounds of push_sprite at position, as expected by draw_wrapped
+  [[nodiscard]] static Rectangle sprite_bounds(const Sprite &sprite, const Vector2 &position, float scale = 1.0f);
+
+private:
+  enum class Kind : uint8_t
+  {
+    Sprite,
+    Circle
+  };
+
+  struct Command
+  {
+    // layer | texture id | recording order, sorting by key keeps the recording order within a batch
+    uint64_t key{ 0 };
+    Kind kind{ Kind::Sprite };
+    Texture2D texture{};
+    Rectangle source{};
+    Rectangle destination{}; // center and radius in x, y and width for circles
+    Vector2 origin{};
+    Color tint{ WHITE };
+  };
+
+  [[nodiscard]] uint64_t make_key(RenderLayer layer, unsigned int texture_id) const noexcept;
+
+  std::vector<Command> commands;
+};
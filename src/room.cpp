@@ -160,6 +160,11 @@ void Room::load()
 
     if (level.layer_instances.has_value())
     {
+      std::vector<Tile> foreground_tiles;
+      std::vector<Tile> background_tiles;
+      float foreground_tile_size = 1.0f;
+      float background_tile_size = 1.0f;
+
       const auto &layer_instances = level.layer_instances.value();
       for (const auto &layer : layer_instances)
       {
@@ -211,13 +216,22 @@ void Room::load()
         for (const auto &tile_instance : layer.grid_tiles)
         {
           if (layer_name == "ForegroundTiles")
-            room->foreground_tiles.emplace_back(tile_from_ldtk_tile(tile_instance, tile_size));
+          {
+            foreground_tiles.emplace_back(tile_from_ldtk_tile(tile_instance, tile_size));
+            foreground_tile_size = static_cast<float>(tile_size);
+          }
           else if (layer_name == "BackgroundTiles")
-            room->background_tiles.emplace_back(tile_from_ldtk_tile(tile_instance, tile_size));
+          {
+            background_tiles.emplace_back(tile_from_ldtk_tile(tile_instance, tile_size));
+            background_tile_size = static_cast<float>(tile_size);
+          }
         }
-        TraceLog(LOG_TRACE, "   > Loaded %d background tiles", room->foreground_tiles.size());
-        TraceLog(LOG_TRACE, "   > Loaded %d foreground tiles", room->background_tiles.size());
+        TraceLog(LOG_TRACE, "   > Loaded %d foreground tiles", foreground_tiles.size());
+        TraceLog(LOG_TRACE, "   > Loaded %d background tiles", background_tiles.size());
       }
+
+      room->foreground_tiles = TileChunks(std::move(foreground_tiles), foreground_tile_size);
+      room->background_tiles = TileChunks(std::move(background_tiles), background_tile_size);
     }
 
     rooms.emplace(room_type.value(), room);
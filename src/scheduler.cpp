@@ -0,0 +1,134 @@
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#include <raylib.h>
+
+#include "utils.hpp"
+
+static constexpr const float COST_SMOOTHING{ 0.1f };
+static constexpr const float MIN_LOAD_SCALE{ 0.25f };
+
+Scheduler::JobId Scheduler::add_job(JobDescription &&description)
+{
+  assert(description.period_ticks > 0);
+  assert(description.chunk_size > 0);
+  assert(description.work_size);
+  assert(description.run);
+
+  TraceLog(LOG_TRACE,
+           "Scheduler: adding job \"%s\" (every %u ticks, %.0fus budget)",
+           description.name.c_str(),
+           description.period_ticks,
+           description.budget_us);
+
+  Job job{ .description = std::move(description) };
+  // NOTE: Jobs sharing a period start their passes on different ticks
+  job.phase = static_cast<uint32_t>(jobs.size() % job.description.period_ticks);
+  jobs.push_back(std::move(job));
+  return jobs.size() - 1;
+}
+
+void Scheduler::set_period(JobId id, uint32_t period_ticks)
+{
+  assert(period_ticks > 0);
+  Job &job = jobs.at(id);
+  if (job.description.period_ticks == period_ticks)
+    return;
+
+  job.description.period_ticks = period_ticks;
+  job.phase                    = job.phase % period_ticks;
+}
+
+void Scheduler::update(float frame_time)
+{
+  if (frame_time > DELTA_TIME * 1.1f)
+    load_scale = std::max(MIN_LOAD_SCALE, load_scale * 0.9f);
+  else
+    load_scale = std::min(1.0f, load_scale + 0.02f);
+
+  for (auto &job : jobs)
+    run_job(job);
+
+  tick++;
+}
+
+void Scheduler::run_job(Job &job)
+{
+  const JobDescription &description = job.description;
+
+  if (!job.running)
+  {
+    if ((tick + job.phase) % description.period_ticks != 0)
+      return;
+
+    job.pass_size = description.work_size();
+    if (job.pass_size == 0)
+      return;
+
+    job.cursor          = 0;
+    job.pass_start_tick = tick;
+    job.running         = true;
+  }
+
+  const uint64_t ticks_elapsed = tick - job.pass_start_tick;
+  const uint64_t ticks_left    = ticks_elapsed < description.period_ticks ? description.period_ticks - ticks_elapsed : 1;
+  const size_t remaining       = job.pass_size - job.cursor;
+  const size_t quota           = static_cast<size_t>((remaining + ticks_left - 1) / ticks_left);
+  const float budget_us        = description.budget_us * load_scale;
+
+  const auto start_time = std::chrono::steady_clock::now();
+  float elapsed_us      = 0.0f;
+  size_t processed      = 0;
+
+  // NOTE: At least one chunk is processed every tick, so a job always makes progress
+  while (processed < quota)
+  {
+    const size_t count = std::min(description.chunk_size, quota - processed);
+    description.run(job.cursor, job.cursor + count);
+    job.cursor += count;
+    processed += count;
+
+    elapsed_us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start_time).count();
+    if (elapsed_us >= budget_us)
+      break;
+  }
+
+  JobStats &stats = job.stats;
+  stats.cost_us += (elapsed_us - stats.cost_us) * COST_SMOOTHING;
+  stats.cost_per_unit_us += (elapsed_us / static_cast<float>(processed) - stats.cost_per_unit_us) * COST_SMOOTHING;
+
+  if (job.cursor >= job.pass_size)
+  {
+    job.running = false;
+    stats.passes++;
+    if (ticks_elapsed >= description.period_ticks)
+      stats.late_passes++;
+  }
+}
+
+void Scheduler::draw_debug() const noexcept
+{
+  const int font_size = 10;
+  int y               = 50;
+
+  DrawText(TextFormat("Scheduler load scale: %.2f", load_scale), 40, y, font_size, GOLD);
+  y += font_size + 2;
+
+  for (const auto &job : jobs)
+  {
+    DrawText(TextFormat("%-16s %7.1fus %6.3fus/unit passes: %llu late: %llu",
+                        job.description.name.c_str(),
+                        job.stats.cost_us,
+                        job.stats.cost_per_unit_us,
+                        static_cast<unsigned long long>(job.stats.passes),
+                        static_cast<unsigned long long>(job.stats.late_passes)),
+             40,
+             y,
+             font_size,
+             GOLD);
+    y += font_size + 2;
+  }
+}
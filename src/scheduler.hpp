@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// NOTE: Amortizes non-critical per-tick work. A job is a list of work units (particles, NPCs, quests...)
+//       that has to be walked once every `period_ticks`; the walk is spread evenly over the period
+//       and cut short when the job runs out of its microsecond budget for the tick.
+//       Budgets shrink while frames take longer than DELTA_TIME and recover when there is headroom.
+class Scheduler
+{
+public:
+  struct JobDescription
+  {
+    std::string name{};
+    uint32_t period_ticks{ 1 };
+    float budget_us{ 500.0f };
+    size_t chunk_size{ 64 };
+    std::function<size_t()> work_size{};
+    std::function<void(size_t begin, size_t end)> run{};
+  };
+
+  struct JobStats
+  {
+    float cost_us{ 0.0f };          // exponential moving average of time spent per tick
+    float cost_per_unit_us{ 0.0f }; // exponential moving average of time spent per work unit
+    uint64_t passes{ 0 };
+    uint64_t late_passes{ 0 }; // passes that did not fit into their period
+  };
+
+  using JobId = size_t;
+
+  JobId add_job(JobDescription &&description);
+  // NOTE: Takes effect from the next pass of the job
+  void set_period(JobId id, uint32_t period_ticks);
+
+  void update(float frame_time);
+  void draw_debug() const noexcept;
+
+  [[nodiscard]] const JobStats &get_stats(JobId id) const { return jobs.at(id).stats; }
+  [[nodiscard]] float get_load_scale() const noexcept { return load_scale; }
+
+private:
+  struct Job
+  {
+    JobDescription description;
+    JobStats stats{};
+    size_t cursor{ 0 };
+    size_t pass_size{ 0 };
+    uint64_t pass_start_tick{ 0 };
+    uint32_t phase{ 0 };
+    bool running{ false };
+  };
+
+  std::vector<Job> jobs;
+  uint64_t tick{ 0 };
+  float load_scale{ 1.0f };
+
+  void run_job(Job &job);
+};
@@ -0,0 +1,123 @@
+#include "script.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <exception>
+#include <new>
+#include <utility>
+
+#include <raylib.h>
+
+#include "game.hpp"
+
+namespace
+{
+// NOTE: Only the main thread runs scripts, the pool is not synchronized
+struct FramePool
+{
+  struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) Block
+  {
+    std::byte data[Script::FRAME_POOL_BLOCK_SIZE];
+  };
+
+  std::array<Block, Script::FRAME_POOL_BLOCK_COUNT> blocks;
+  std::bitset<Script::FRAME_POOL_BLOCK_COUNT> used;
+
+  [[nodiscard]] bool owns(const void *ptr) const noexcept
+  {
+    const auto *byte = static_cast<const std::byte *>(ptr);
+    return byte >= blocks.front().data && byte <= blocks.back().data;
+  }
+};
+
+FramePool frame_pool;
+} // namespace
+
+void Script::promise_type::unhandled_exception() const noexcept
+{
+  TraceLog(LOG_ERROR, "Script: unhandled exception");
+  std::terminate();
+}
+
+void *Script::promise_type::operator new(size_t size)
+{
+  if (size <= FRAME_POOL_BLOCK_SIZE)
+  {
+    for (size_t i = 0; i < FRAME_POOL_BLOCK_COUNT; i++)
+    {
+      if (!frame_pool.used[i])
+      {
+        frame_pool.used[i] = true;
+        return frame_pool.blocks[i].data;
+      }
+    }
+  }
+
+  TraceLog(LOG_WARNING, "Script: frame of %zu bytes allocated from the heap", size);
+  return ::operator new(size);
+}
+
+void Script::promise_type::operator delete(void *ptr, size_t size) noexcept
+{
+  if (!frame_pool.owns(ptr))
+  {
+    ::operator delete(ptr, size);
+    return;
+  }
+
+  const auto index = static_cast<size_t>(reinterpret_cast<FramePool::Block *>(ptr) - frame_pool.blocks.data());
+  frame_pool.used[index] = false;
+}
+
+Script::~Script()
+{
+  if (handle)
+    handle.destroy();
+}
+
+Script::Script(Script &&other) noexcept
+  : handle(std::exchange(other.handle, nullptr))
+{
+}
+
+Script &Script::operator=(Script &&other) noexcept
+{
+  if (this == &other)
+    return *this;
+
+  if (handle)
+    handle.destroy();
+  handle = std::exchange(other.handle, nullptr);
+
+  return *this;
+}
+
+void Script::update()
+{
+  if (!is_done())
+    handle.resume();
+}
+
+void Script::draw() const noexcept
+{
+  if (is_done())
+    return;
+
+  const float progress = handle.promise().progress;
+  const Vector2 center = { Game::width * 0.5f, Game::height * 0.5f };
+  switch (handle.promise().overlay)
+  {
+    case Overlay::None:
+      break;
+    case Overlay::Iris:
+      DrawPoly(center, 16, std::max(Game::width, Game::height) * 0.5f * progress, progress * 0.1f, BLACK);
+      break;
+    case Overlay::Ring:
+      DrawRing(center, Game::width * progress, Game::width, 0.0f, 360.0f, 16, BLACK);
+      break;
+    case Overlay::Black:
+      DrawRectangle(0, 0, Game::width, Game::height, Color{ 0, 0, 0, static_cast<unsigned char>(255.0f * progress) });
+      break;
+  }
+}
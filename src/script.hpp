@@ -0,0 +1,80 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+// NOTE: Coroutine for scripted sequences like level transitions. The body runs from the first update, every
+//       co_await next_tick() hands control back until the next tick, and the overlay given to it is what
+//       draw() shows meanwhile. Coroutine frames come from a small fixed pool, scheduling a script does not
+//       touch the heap unless the pool is exhausted or a frame is larger than a block.
+class Script
+{
+public:
+  enum class Overlay : uint8_t
+  {
+    None,
+    Iris,  // black polygon closing in, progress 0 to 1
+    Ring,  // black ring opening, progress 0 to 1
+    Black, // black screen, progress is the opacity
+  };
+
+  struct promise_type
+  {
+    Overlay overlay{ Overlay::None };
+    float progress{ 0.0f };
+
+    [[nodiscard]] Script get_return_object() noexcept
+    {
+      return Script{ std::coroutine_handle<promise_type>::from_promise(*this) };
+    }
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+    [[nodiscard]] std::suspend_always final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept;
+
+    [[nodiscard]] static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size) noexcept;
+  };
+
+  struct NextTick
+  {
+    Overlay overlay{ Overlay::None };
+    float progress{ 0.0f };
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+    {
+      handle.promise().overlay  = overlay;
+      handle.promise().progress = progress;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  static constexpr const size_t FRAME_POOL_BLOCK_SIZE{ 1024 };
+  static constexpr const size_t FRAME_POOL_BLOCK_COUNT{ 8 };
+
+  // suspends the script until the next tick, showing overlay in between
+  [[nodiscard]] static NextTick next_tick(Overlay overlay = Overlay::None, float progress = 0.0f) noexcept
+  {
+    return NextTick{ .overlay = overlay, .progress = progress };
+  }
+
+  Script() noexcept = default;
+  ~Script();
+
+  Script(const Script &)            = delete;
+  Script &operator=(const Script &) = delete;
+  Script(Script &&other) noexcept;
+  Script &operator=(Script &&other) noexcept;
+
+  // runs the script until its next co_await
+  void update();
+  void draw() const noexcept;
+  [[nodiscard]] bool is_done() const noexcept { return !handle || handle.done(); }
+
+private:
+  explicit Script(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+  std::coroutine_handle<promise_type> handle;
+};
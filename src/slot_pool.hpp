@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#define DECLARE_FRIEND_SLOT_POOL() \
+  template<typename T, size_t N>   \
+  friend struct SlotPool;
+
+// NOTE: Fixed capacity pool where objects stay in the slot they were pushed to until removed, unlike
+//       ObjectCircularBuffer which moves the last object into a removed slot. A slot and something
+//       identifying the object (like an id) can be kept as a handle, e.g. by a timing wheel event.
+template<typename T, size_t CAPACITY>
+struct SlotPool
+{
+  static constexpr const size_t NO_SLOT{ std::numeric_limits<size_t>::max() };
+
+  T objects[CAPACITY];
+  std::bitset<CAPACITY> used;
+  size_t count{ 0 };
+  size_t next_free{ 0 }; // lowest slot that may be free
+  const size_t capacity{ CAPACITY };
+
+  // returns the slot of the object, or NO_SLOT when the pool is full and the object was dropped
+  size_t push(T &&obj)
+  {
+    if (count == CAPACITY)
+      return NO_SLOT;
+
+    size_t slot = next_free;
+    while (used[slot])
+      slot++;
+
+    objects[slot] = std::move(obj);
+    used[slot]    = true;
+    next_free     = slot + 1;
+    count++;
+    return slot;
+  }
+
+  // object in slot, nullptr when the slot is free
+  [[nodiscard]] T *get(size_t slot) noexcept { return slot < CAPACITY && used[slot] ? &objects[slot] : nullptr; }
+
+  void remove(size_t slot) noexcept
+  {
+    if (slot >= CAPACITY || !used[slot])
+      return;
+
+    used[slot] = false;
+    next_free  = std::min(next_free, slot);
+    count--;
+  }
+
+  [[nodiscard]] constexpr size_t size() const noexcept { return count; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+
+  void clear() noexcept
+  {
+    used.reset();
+    count     = 0;
+    next_free = 0;
+  }
+
+  // objects for which func returns false are removed, like ObjectCircularBuffer::for_each
+  void for_each(auto func)
+  {
+    for (size_t slot = 0, visited = 0; slot < CAPACITY && visited < count; slot++)
+    {
+      if (!used[slot])
+        continue;
+
+      if constexpr (std::is_same_v<decltype(func(objects[slot])), bool>)
+      {
+        if (!func(objects[slot]))
+        {
+          remove(slot);
+          continue;
+        }
+      }
+      else
+      {
+        func(objects[slot]);
+      }
+      visited++;
+    }
+  }
+
+  void for_each(auto func) const
+  {
+    for (size_t slot = 0, visited = 0; slot < CAPACITY && visited < count; slot++)
+    {
+      if (!used[slot])
+        continue;
+
+      func(objects[slot]);
+      visited++;
+    }
+  }
+};
@@ -0,0 +1,73 @@
+#include "software_framebuffer.hpp"
+
+#include <cassert>
+#include <cstring>
+
+SoftwareFramebuffer::SoftwareFramebuffer(int width, int height)
+  : width(width), height(height), pixels(static_cast<size_t>(width) * static_cast<size_t>(height), 0)
+{
+  assert(width > 0 && height > 0);
+
+  used_top      = height;
+  used_bottom   = 0;
+  upload_top    = 0;
+  upload_bottom = height;
+}
+
+SoftwareFramebuffer::~SoftwareFramebuffer()
+{
+  if (IsTextureReady(texture))
+    UnloadTexture(texture);
+}
+
+void SoftwareFramebuffer::clear() noexcept
+{
+  if (used_top >= used_bottom)
+    return;
+
+  const size_t row_size = static_cast<size_t>(width);
+  std::memset(pixels.data() + static_cast<size_t>(used_top) * row_size,
+              0,
+              static_cast<size_t>(used_bottom - used_top) * row_size * sizeof(uint32_t));
+
+  upload_top    = std::min(upload_top, used_top);
+  upload_bottom = std::max(upload_bottom, used_bottom);
+  used_top      = height;
+  used_bottom   = 0;
+}
+
+void SoftwareFramebuffer::upload() noexcept
+{
+  if (!IsTextureReady(texture))
+  {
+    const Image image{ .data    = pixels.data(),
+                       .width   = width,
+                       .height  = height,
+                       .mipmaps = 1,
+                       .format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    texture = LoadTextureFromImage(image);
+    SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+    assert(IsTextureReady(texture));
+  }
+  else if (upload_top < upload_bottom)
+  {
+    // NOTE: Whole rows are contiguous in memory, so the changed band is a single partial update
+    const Rectangle rows{ 0.0f,
+                          static_cast<float>(upload_top),
+                          static_cast<float>(width),
+                          static_cast<float>(upload_bottom - upload_top) };
+    UpdateTextureRec(texture, rows, pixels.data() + static_cast<size_t>(upload_top) * static_cast<size_t>(width));
+  }
+
+  upload_top    = height;
+  upload_bottom = 0;
+}
+
+void SoftwareFramebuffer::draw(const Vector2 &position) noexcept
+{
+  upload();
+
+  BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+  DrawTextureV(texture, position, WHITE);
+  EndBlendMode();
+}
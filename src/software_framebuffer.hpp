@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <raylib.h>
+
+// NOTE: CPU side RGBA image that many single pixel draws are rasterised into, and which is uploaded
+//       and drawn as one texture. Pixels are stored premultiplied, so blending a pixel in gives the
+//       same result as drawing it directly with BLEND_ALPHA. Only upload() and draw() touch the GPU.
+class SoftwareFramebuffer
+{
+public:
+  SoftwareFramebuffer(int width, int height);
+  ~SoftwareFramebuffer();
+
+  SoftwareFramebuffer(const SoftwareFramebuffer &)            = delete;
+  SoftwareFramebuffer(SoftwareFramebuffer &&)                 = delete;
+  SoftwareFramebuffer &operator=(const SoftwareFramebuffer &) = delete;
+  SoftwareFramebuffer &operator=(SoftwareFramebuffer &&)      = delete;
+
+  // clears only the rows touched since the previous clear
+  void clear() noexcept;
+
+  void blend_pixel(int x, int y, const Color &color) noexcept
+  {
+    if (x < 0 || y < 0 || x >= width || y >= height || color.a == 0)
+      return;
+
+    touch_row(y);
+    uint32_t &pixel = pixels[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)];
+    pixel           = blend(pixel, std::bit_cast<uint32_t>(color));
+  }
+
+  // uploads the touched rows, does nothing when nothing changed since the last upload
+  void upload() noexcept;
+  // draws the framebuffer with its top left corner at position, uploading it first if needed
+  void draw(const Vector2 &position) noexcept;
+
+  [[nodiscard]] int get_width() const noexcept { return width; }
+  [[nodiscard]] int get_height() const noexcept { return height; }
+  // premultiplied RGBA pixels, row by row
+  [[nodiscard]] std::span<const uint32_t> get_pixels() const noexcept { return pixels; }
+
+  // NOTE: Source over blending of a straight alpha colour into a premultiplied pixel. Red/blue and
+  //       green/alpha are processed in pairs, two 8 bit channels per 32 bit multiply.
+  [[nodiscard]] static constexpr uint32_t blend(uint32_t destination, uint32_t source) noexcept
+  {
+    const uint32_t alpha = source >> 24;
+    // NOTE: Setting the source alpha byte to 255 makes the multiply below produce it premultiplied as well
+    const uint32_t premultiplied = scale(source | 0xFF000000u, alpha);
+    return premultiplied + scale(destination, 255 - alpha);
+  }
+
+private:
+  // each channel multiplied by factor / 255, rounded
+  [[nodiscard]] static constexpr uint32_t scale(uint32_t pixel, uint32_t factor) noexcept
+  {
+    uint32_t red_blue    = (pixel & 0x00FF00FFu) * factor + 0x00800080u;
+    uint32_t green_alpha = ((pixel >> 8) & 0x00FF00FFu) * factor + 0x00800080u;
+    red_blue             = ((red_blue + ((red_blue >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+    green_alpha          = (green_alpha + ((green_alpha >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+    return red_blue | green_alpha;
+  }
+
+  void touch_row(int y) noexcept
+  {
+    used_top      = std::min(used_top, y);
+    used_bottom   = std::max(used_bottom, y + 1);
+    upload_top    = std::min(upload_top, y);
+    upload_bottom = std::max(upload_bottom, y + 1);
+  }
+
+  int width{ 0 };
+  int height{ 0 };
+  std::vector<uint32_t> pixels;
+
+  // rows [used_top, used_bottom) may contain pixels, rows [upload_top, upload_bottom) changed since the last upload
+  int used_top{ 0 };
+  int used_bottom{ 0 };
+  int upload_top{ 0 };
+  int upload_bottom{ 0 };
+
+  Texture2D texture{};
+};
@@ -1,4 +1,234 @@
 #include "sound_manager.hpp"
 
-std::unordered_map<std::string, SoundManager::Sound> SoundManager::sounds;
+#include <algorithm>
+
+std::unordered_map<std::string, size_t> SoundManager::source_indices;
+std::unordered_map<std::string, SoundManager::Options> SoundManager::options;
+std::vector<SoundManager::Source> SoundManager::sources;
+std::vector<SoundManager::Trigger> SoundManager::triggers;
+uint64_t SoundManager::trigger_count{ 0 };
+uint32_t SoundManager::owner_count{ 0 };
 float SoundManager::volume{ 0.5f };
+
+SoundManager::Sound::Sound(size_t source)
+  : source{ source }, owner{ next_owner() }
+{
+}
+
+SoundManager::Sound::Sound(const Sound &other)
+  : volume{ other.volume }, source{ other.source }, owner{ next_owner() }
+{
+}
+
+SoundManager::Sound &SoundManager::Sound::operator=(const Sound &other)
+{
+  if (this == &other)
+    return *this;
+
+  // NOTE: Voices started by the previous sound keep playing, they are not owned by this handle anymore
+  owner = next_owner();
+
+  volume = other.volume;
+  source = other.source;
+
+  return *this;
+}
+
+void SoundManager::Sound::play() const
+{
+  if (!is_loaded())
+    return;
+
+  SoundManager::trigger(*this);
+}
+
+void SoundManager::Sound::stop() const
+{
+  if (source >= sources.size())
+    return;
+
+  std::erase_if(triggers, [this](const Trigger &trigger) { return trigger.owner == owner; });
+
+  for (auto &voice : sources[source].voices)
+  {
+    if (voice.owner == owner && IsSoundPlaying(voice.ray_sound))
+      StopSound(voice.ray_sound);
+  }
+}
+
+void SoundManager::Sound::set_volume(float new_volume)
+{
+  volume = new_volume;
+  if (source >= sources.size())
+    return;
+
+  for (auto &voice : sources[source].voices)
+  {
+    if (voice.owner == owner)
+      SetSoundVolume(voice.ray_sound, new_volume * SoundManager::volume);
+  }
+}
+
+bool SoundManager::Sound::is_playing() const
+{
+  if (source >= sources.size())
+    return false;
+
+  if (std::any_of(triggers.begin(), triggers.end(), [this](const Trigger &trigger) { return trigger.owner == owner; }))
+    return true;
+
+  const auto &voices = sources[source].voices;
+  return std::any_of(voices.begin(),
+                     voices.end(),
+                     [this](const Voice &voice) { return voice.owner == owner && IsSoundPlaying(voice.ray_sound); });
+}
+
+bool SoundManager::Sound::is_loaded() const
+{
+  return source < sources.size() && IsSoundReady(sources[source].ray_sound);
+}
+
+SoundManager::Sound SoundManager::get(const std::string &name)
+{
+  if (const auto it = source_indices.find(name); it != source_indices.end())
+    return Sound(it->second);
+
+  const Options &source_options = options[name];
+
+  Source source;
+  source.ray_sound = LoadSound(name.c_str());
+  source.priority  = source_options.priority;
+  if (IsSoundReady(source.ray_sound))
+  {
+    source.voices.resize(std::max<size_t>(source_options.polyphony, 1));
+    source.voices[0].ray_sound = source.ray_sound;
+    for (size_t i = 1; i < source.voices.size(); i++)
+      source.voices[i].ray_sound = LoadSoundAlias(source.ray_sound);
+  }
+
+  const size_t index = sources.size();
+  sources.push_back(std::move(source));
+  source_indices.emplace(name, index);
+
+  TraceLog(LOG_TRACE, "SoundManager: loaded \"%s\" with %zu voices", name.c_str(), sources[index].voices.size());
+  return Sound(index);
+}
+
+void SoundManager::configure(const std::string &name, size_t polyphony, Priority priority)
+{
+  assert(!source_indices.contains(name));
+  options[name] = Options{ .polyphony = polyphony, .priority = priority };
+}
+
+void SoundManager::trigger(const Sound &sound)
+{
+  const float trigger_volume = sound.volume.value_or(1.0f);
+
+  // NOTE: Identical triggers of a frame are one louder voice, owned by the first handle
+  const auto it = std::find_if(
+    triggers.begin(), triggers.end(), [&sound](const Trigger &trigger) { return trigger.source == sound.source; });
+  if (it != triggers.end())
+  {
+    it->volume = std::min(it->volume + trigger_volume, 1.0f);
+    return;
+  }
+
+  triggers.push_back(Trigger{ .source = sound.source, .owner = sound.owner, .volume = std::min(trigger_volume, 1.0f) });
+}
+
+void SoundManager::update()
+{
+  // NOTE: Higher priorities are played first, so they are not the ones to find the pool full
+  std::stable_sort(triggers.begin(),
+                   triggers.end(),
+                   [](const Trigger &a, const Trigger &b)
+                   { return sources[a.source].priority > sources[b.source].priority; });
+
+  for (const auto &trigger : triggers)
+  {
+    Voice *voice = find_voice(trigger.source);
+    if (!voice)
+      continue;
+
+    voice->owner   = trigger.owner;
+    voice->started = ++trigger_count;
+    SetSoundVolume(voice->ray_sound, trigger.volume * volume);
+    PlaySound(voice->ray_sound);
+  }
+
+  triggers.clear();
+}
+
+SoundManager::Voice *SoundManager::find_voice(size_t source_index)
+{
+  Source &source = sources[source_index];
+
+  // NOTE: A free voice of the sound, or its oldest one when it plays on all of them
+  Voice *voice = nullptr;
+  for (auto &candidate : source.voices)
+  {
+    if (!IsSoundPlaying(candidate.ray_sound))
+    {
+      voice = &candidate;
+      break;
+    }
+    if (!voice || candidate.started < voice->started)
+      voice = &candidate;
+  }
+
+  if (!voice || IsSoundPlaying(voice->ray_sound) || get_playing_count() < MAX_VOICES)
+    return voice;
+
+  // NOTE: The pool is full, steal the lowest priority voice that is not above this sound, the oldest first
+  Voice *stolen            = nullptr;
+  Priority stolen_priority = source.priority;
+  for (auto &other : sources)
+  {
+    if (other.priority > source.priority)
+      continue;
+
+    for (auto &candidate : other.voices)
+    {
+      if (!IsSoundPlaying(candidate.ray_sound))
+        continue;
+
+      if (!stolen || other.priority < stolen_priority ||
+          (other.priority == stolen_priority && candidate.started < stolen->started))
+      {
+        stolen          = &candidate;
+        stolen_priority = other.priority;
+      }
+    }
+  }
+
+  if (!stolen)
+    return nullptr;
+
+  StopSound(stolen->ray_sound);
+  return voice;
+}
+
+size_t SoundManager::get_playing_count()
+{
+  size_t count = 0;
+  for (const auto &source : sources)
+    count += static_cast<size_t>(std::count_if(source.voices.begin(),
+                                               source.voices.end(),
+                                               [](const Voice &voice) { return IsSoundPlaying(voice.ray_sound); }));
+  return count;
+}
+
+void SoundManager::clear()
+{
+  triggers.clear();
+
+  for (auto &source : sources)
+  {
+    for (size_t i = 1; i < source.voices.size(); i++)
+      UnloadSoundAlias(source.voices[i].ray_sound);
+    UnloadSound(source.ray_sound);
+  }
+
+  sources.clear();
+  source_indices.clear();
+}
@@ -1,108 +1,113 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <raylib.h>
 
+// NOTE: Every sound file is loaded once with a fixed set of voices (the original sound and its aliases), so
+//       playing never loads anything. Triggers are collected during the frame and played by update(): the
+//       triggers of the same sound are merged into one voice with their volumes summed, at most MAX_VOICES
+//       play at once, and a full sound or pool steals the voice with the lowest priority, then the oldest.
 class SoundManager
 {
 public:
+  static constexpr const size_t MAX_VOICES{ 16 };
+  static constexpr const size_t DEFAULT_POLYPHONY{ 2 };
+  static constexpr const size_t NO_SOURCE{ SIZE_MAX };
+
+  enum class Priority : uint8_t
+  {
+    Low,    // repeated effects, like explosions
+    Normal, // gameplay feedback
+    High    // interface and loops that must not cut out
+  };
+
+  // NOTE: Handles are cheap to copy. Every copy is a separate owner, so is_playing, stop and set_volume
+  //       only affect the voices it started.
   struct Sound
   {
     Sound() = default;
-    Sound(const Sound &other)
-      : volume{ other.volume }
-    {
-      ray_sound = LoadSoundAlias(other.ray_sound);
-    }
-    Sound(Sound &&other) = delete;
+    Sound(const Sound &other);
 
-    Sound(std::string_view path) { ray_sound = LoadSound(path.data()); }
+    Sound &operator=(const Sound &other);
 
-    Sound &operator=(const Sound &other)
-    {
-      if (this == &other)
-        return *this;
+    void play() const;
+    void stop() const;
+    void set_volume(float new_volume);
 
-      volume    = other.volume;
-      ray_sound = LoadSoundAlias(other.ray_sound);
+    [[nodiscard]] bool is_playing() const;
+    [[nodiscard]] bool is_loaded() const;
 
-      return *this;
-    }
+    std::optional<float> volume;
 
-    Sound &operator=(Sound &&other) = delete;
+  private:
+    explicit Sound(size_t source);
 
-    void play() const
-    {
-      if (!IsSoundReady(ray_sound))
-        return;
+    size_t source{ NO_SOURCE };
+    uint32_t owner{ 0 };
 
-      if (volume)
-      {
-        const float normalized_volume = *volume * SoundManager::volume;
-        SetSoundVolume(ray_sound, normalized_volume);
-      }
-      else
-        SetSoundVolume(ray_sound, SoundManager::volume);
+    friend class SoundManager;
+  };
 
-      PlaySound(ray_sound);
-    }
+  // handle of the sound file, loaded with DEFAULT_POLYPHONY voices and Normal priority on first use
+  [[nodiscard]] static SoundManager::Sound get(const std::string &name);
 
-    void stop() const
-    {
-      if (!IsSoundPlaying(ray_sound))
-        return;
+  // sets the voices and priority of a sound file before it is loaded
+  static void configure(const std::string &name, size_t polyphony, Priority priority);
 
-      StopSound(ray_sound);
-    }
+  // plays the triggers collected since the last call, once per frame
+  static void update();
 
-    void set_volume(float new_volume)
-    {
-      volume                        = new_volume;
-      const float normalized_volume = *volume * SoundManager::volume;
-      SetSoundVolume(ray_sound, normalized_volume);
-    }
+  static void clear();
 
-    bool is_playing() const { return IsSoundPlaying(ray_sound); }
+  [[nodiscard]] static size_t get_playing_count();
 
-    bool is_loaded() const { return IsSoundReady(ray_sound); }
+  static float volume;
 
-    std::optional<float> volume;
-    mutable ::Sound ray_sound;
+private:
+  struct Voice
+  {
+    ::Sound ray_sound{};
+    uint32_t owner{ 0 };
+    uint64_t started{ 0 };
   };
 
-  static SoundManager::Sound &get(std::string name)
+  struct Source
   {
-    if (sounds.contains(name))
-      return sounds[name];
-
-    sounds.insert({ name, SoundManager::Sound(name) });
-    return sounds[name];
-  }
+    ::Sound ray_sound{};
+    std::vector<Voice> voices; // the first voice plays the original sound, the others its aliases
+    Priority priority{ Priority::Normal };
+  };
 
-  static SoundManager::Sound copy(std::string name)
+  struct Trigger
   {
-    if (sounds.contains(name))
-      return Sound(sounds[name]);
-
-    sounds.insert({ name, SoundManager::Sound(name) });
-    return Sound(sounds[name]);
-  }
+    size_t source{ NO_SOURCE };
+    uint32_t owner{ 0 };
+    float volume{ 0.0f };
+  };
 
-  static void clear()
+  struct Options
   {
-    for (auto &[name, sound] : sounds)
-      UnloadSound(sound.ray_sound);
-    sounds.clear();
-  }
+    size_t polyphony{ DEFAULT_POLYPHONY };
+    Priority priority{ Priority::Normal };
+  };
 
-  static float volume;
+  static void trigger(const Sound &sound);
+  [[nodiscard]] static Voice *find_voice(size_t source_index);
+  [[nodiscard]] static uint32_t next_owner() noexcept { return ++owner_count; }
 
-private:
-  static std::unordered_map<std::string, SoundManager::Sound> sounds;
+  static std::unordered_map<std::string, size_t> source_indices;
+  static std::unordered_map<std::string, Options> options;
+  static std::vector<Source> sources;
+  static std::vector<Trigger> triggers;
+  static uint64_t trigger_count;
+  static uint32_t owner_count;
 };
 
 using SMSound = SoundManager::Sound;
@@ -1,6 +1,7 @@
 #include "sprite.hpp"
 
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -168,10 +169,15 @@ size_t Sprite::get_height() const
 }
 
 void Sprite::set_centered()
+{
+  origin = get_centered_origin();
+}
+
+Vector2 Sprite::get_centered_origin() const
 {
   const float origin_x = static_cast<float>(scale.x * get_width()) / 2.0f;
   const float origin_y = static_cast<float>(scale.y * get_height()) / 2.0f;
-  origin               = Vector2{ std::floor(origin_x), std::floor(origin_y) };
+  return Vector2{ std::floor(origin_x), std::floor(origin_y) };
 }
 
 Rectangle Sprite::get_source_rect() const
@@ -184,6 +190,14 @@ Rectangle Sprite::get_source_rect() const
   return Rectangle{ static_cast<float>(frame_index) * sprite_w, 0.0f, h_flip * sprite_w, v_flip * sprite_h };
 }
 
+Rectangle Sprite::get_frame_rect(int frame) const
+{
+  const float sprite_w{ static_cast<float>(get_width()) };
+  const float sprite_h{ static_cast<float>(get_height()) };
+
+  return Rectangle{ static_cast<float>(frame) * sprite_w, 0.0f, sprite_w, sprite_h };
+}
+
 Rectangle Sprite::get_destination_rect() const
 {
   const float sprite_w{ static_cast<float>(get_width()) };
@@ -195,6 +209,18 @@ Rectangle Sprite::get_destination_rect() const
                     sprite_h * fabsf(scale.y) };
 }
 
+Rectangle Sprite::get_bounds(const Vector2 &at_origin) const
+{
+  const Rectangle destination = get_destination_rect();
+  if (rotation == 0.0f)
+    return Rectangle{ destination.x - at_origin.x, destination.y - at_origin.y, destination.width, destination.height };
+
+  // NOTE: The rotation is around the destination position, no corner gets farther from it than radius
+  const float radius = Vector2Length(Vector2{ std::max(at_origin.x, destination.width - at_origin.x),
+                                              std::max(at_origin.y, destination.height - at_origin.y) });
+  return Rectangle{ destination.x - radius, destination.y - radius, 2.0f * radius, 2.0f * radius };
+}
+
 void Sprite::draw() const noexcept
 {
   DrawTexturePro(texture.get(), get_source_rect(), get_destination_rect(), origin, rotation, tint);
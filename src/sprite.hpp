@@ -30,12 +30,19 @@ public:
   void draw() const noexcept;
 
   [[nodiscard]] Texture2D &get_texture();
+  [[nodiscard]] const Texture2D &get_texture() const { return texture.get(); }
 
   [[nodiscard]] size_t get_width() const;
   [[nodiscard]] size_t get_height() const;
 
   [[nodiscard]] Rectangle get_source_rect() const;
+  // source rectangle of any frame, without changing the current one
+  [[nodiscard]] Rectangle get_frame_rect(int frame) const;
   [[nodiscard]] Rectangle get_destination_rect() const;
+  // world rectangle covered by draw(), larger than needed when the sprite is rotated
+  [[nodiscard]] Rectangle get_bounds() const { return get_bounds(origin); }
+  // same, as if the origin was at_origin
+  [[nodiscard]] Rectangle get_bounds(const Vector2 &at_origin) const;
 
   void set_frame(int frame);
   [[nodiscard]] int get_frame() const;
@@ -44,6 +51,7 @@ public:
   void set_tag(const std::string &tag_name);
   inline void set_animation(const std::string &tag_name) { set_tag(tag_name); }
   [[nodiscard]] bool is_playing_animation(const std::string &tag_name) const { return tag == tags.at(tag_name); }
+  [[nodiscard]] const AnimationTag &get_tag(const std::string &tag_name) const { return tags.at(tag_name); }
 
   void reset_animation();
   void animate(int step = 1);
@@ -51,6 +59,8 @@ public:
   const std::string &get_path() const noexcept { return path; }
 
   void set_centered();
+  // origin set_centered() would set with the current size and scale
+  [[nodiscard]] Vector2 get_centered_origin() const;
 
   Vector2 position{ 0.0f, 0.0f };
   Vector2 origin{ 0.0f, 0.0f };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+
+// NOTE: Bounded lock-free queue for exactly one producer thread and one consumer thread. One slot is kept
+//       empty to tell a full queue from an empty one, so it holds CAPACITY - 1 items.
+template<typename T, size_t CAPACITY>
+class SpscQueue
+{
+  static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+  // producer only, returns false when the queue is full
+  [[nodiscard]] bool push(const T &item) noexcept
+  {
+    const size_t head = write_index.load(std::memory_order_relaxed);
+    const size_t next = (head + 1) & (CAPACITY - 1);
+    if (next == read_index.load(std::memory_order_acquire))
+      return false;
+
+    items[head] = item;
+    write_index.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // consumer only
+  [[nodiscard]] std::optional<T> pop() noexcept
+  {
+    const size_t tail = read_index.load(std::memory_order_relaxed);
+    if (tail == write_index.load(std::memory_order_acquire))
+      return std::nullopt;
+
+    T item = items[tail];
+    read_index.store((tail + 1) & (CAPACITY - 1), std::memory_order_release);
+    return item;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return read_index.load(std::memory_order_acquire) == write_index.load(std::memory_order_acquire);
+  }
+
+private:
+  // NOTE: The indices are on their own cache lines, so the two threads do not invalidate each other's line
+  static constexpr const size_t CACHE_LINE{ 64 };
+
+  alignas(CACHE_LINE) std::atomic<size_t> write_index{ 0 };
+  alignas(CACHE_LINE) std::atomic<size_t> read_index{ 0 };
+  alignas(CACHE_LINE) std::array<T, CAPACITY> items{};
+};
@@ -0,0 +1,169 @@
+#include "targeting.hpp"
+
+#include <cassert>
+
+#include "game.hpp"
+
+static_assert(TargetIndex::WORLD_WIDTH == Game::width);
+static_assert(TargetIndex::WORLD_HEIGHT == Game::height);
+static_assert(TargetIndex::COLUMNS * TargetIndex::ROWS < std::numeric_limits<uint16_t>::max());
+
+void TargetIndex::build(const AsteroidPools &asteroids)
+{
+  unsorted_targets.clear();
+  target_cells.clear();
+  id_lookup.clear();
+  cell_start.fill(0);
+
+  asteroids.for_each(
+    [&](const Asteroid &asteroid)
+    {
+      if (asteroid.life == 0)
+        return;
+
+      const int cell = row_of(asteroid.position.y) * COLUMNS + column_of(asteroid.position.x);
+      unsorted_targets.push_back(Target{ asteroid.position, asteroid.id, asteroid.type });
+      target_cells.push_back(static_cast<uint16_t>(cell));
+      cell_start[cell + 1]++;
+    });
+
+  assert(unsorted_targets.size() < std::numeric_limits<uint16_t>::max());
+
+  // NOTE: Counting sort, targets of one cell end up next to each other
+  for (size_t cell = 1; cell < cell_start.size(); ++cell)
+    cell_start[cell] += cell_start[cell - 1];
+
+  std::array<uint16_t, COLUMNS * ROWS> cell_fill{};
+  targets.resize(unsorted_targets.size());
+  for (size_t i = 0; i < unsorted_targets.size(); ++i)
+  {
+    const uint16_t cell  = target_cells[i];
+    const uint16_t index = cell_start[cell] + cell_fill[cell]++;
+    targets[index]       = unsorted_targets[i];
+    id_lookup.emplace_back(unsorted_targets[i].id, index);
+  }
+
+  std::sort(id_lookup.begin(), id_lookup.end());
+}
+
+void TargetIndex::clear() noexcept
+{
+  targets.clear();
+  unsorted_targets.clear();
+  target_cells.clear();
+  id_lookup.clear();
+  cell_start.fill(0);
+}
+
+const Target *TargetIndex::find(uint32_t id) const noexcept
+{
+  if (id == 0)
+    return nullptr;
+
+  const auto it = std::lower_bound(id_lookup.begin(),
+                                   id_lookup.end(),
+                                   id,
+                                   [](const std::pair<uint32_t, uint16_t> &entry, uint32_t id) { return entry.first < id; });
+  if (it == id_lookup.end() || it->first != id)
+    return nullptr;
+
+  return &targets[it->second];
+}
+
+const Target *TargetIndex::nearest(const Vector2 &position, float max_distance) const noexcept
+{
+  return nearest_if(position, max_distance, [](const Target &, const Vector2 &, float) { return true; });
+}
+
+const Target *TargetIndex::nearest_of_type(const Vector2 &position, Asteroid::Type type, float max_distance) const noexcept
+{
+  return nearest_if(position,
+                    max_distance,
+                    [type](const Target &target, const Vector2 &, float) { return target.type == type; });
+}
+
+const Target *TargetIndex::nearest_in_cone(const Vector2 &position,
+                                           const Vector2 &direction,
+                                           float cos_half_angle,
+                                           float max_distance) const noexcept
+{
+  return nearest_if(position,
+                    max_distance,
+                    [&](const Target &, const Vector2 &delta, float distance_sq)
+                    {
+                      // NOTE: dot(direction, delta) >= cos * |delta| without the square root
+                      const float dot      = direction.x * delta.x + direction.y * delta.y;
+                      const float bound_sq = cos_half_angle * cos_half_angle * distance_sq;
+                      if (cos_half_angle >= 0.0f)
+                        return dot >= 0.0f && dot * dot >= bound_sq;
+                      return dot >= 0.0f || dot * dot <= bound_sq;
+                    });
+}
+
+size_t TargetIndex::nearest_k(const Vector2 &position, std::span<const Target *> result, float max_distance) const noexcept
+{
+  if (result.empty())
+    return 0;
+
+  std::array<float, 16> distances_buffer;
+  assert(result.size() <= distances_buffer.size());
+  const size_t k = std::min(result.size(), distances_buffer.size());
+
+  size_t found = 0;
+  const float max_distance_sq =
+    max_distance < std::numeric_limits<float>::max() ? max_distance * max_distance : std::numeric_limits<float>::max();
+
+  search(
+    position,
+    [&](const Target &target, const Vector2 &, float distance_sq)
+    {
+      if (distance_sq >= max_distance_sq)
+        return;
+      if (found == k && distance_sq >= distances_buffer[k - 1])
+        return;
+
+      // NOTE: Insertion into the short sorted result list
+      size_t i = found < k ? found++ : k - 1;
+      while (i > 0 && distances_buffer[i - 1] > distance_sq)
+      {
+        distances_buffer[i] = distances_buffer[i - 1];
+        result[i]           = result[i - 1];
+        --i;
+      }
+      distances_buffer[i] = distance_sq;
+      result[i]           = &target;
+    },
+    [&](float ring_distance_sq)
+    { return ring_distance_sq >= max_distance_sq || (found == k && ring_distance_sq >= distances_buffer[k - 1]); });
+
+  return found;
+}
+
+Vector2 TargetIndex::wrapped_delta(const Vector2 &from, const Vector2 &to) noexcept
+{
+  Vector2 delta{ to.x - from.x, to.y - from.y };
+
+  if (delta.x > WORLD_WIDTH * 0.5f)
+    delta.x -= WORLD_WIDTH;
+  else if (delta.x < -WORLD_WIDTH * 0.5f)
+    delta.x += WORLD_WIDTH;
+
+  if (delta.y > WORLD_HEIGHT * 0.5f)
+    delta.y -= WORLD_HEIGHT;
+  else if (delta.y < -WORLD_HEIGHT * 0.5f)
+    delta.y += WORLD_HEIGHT;
+
+  return delta;
+}
+
+int TargetIndex::column_of(float x) noexcept
+{
+  const int column = static_cast<int>(x) / CELL_SIZE;
+  return std::clamp(column, 0, COLUMNS - 1);
+}
+
+int TargetIndex::row_of(float y) noexcept
+{
+  const int row = static_cast<int>(y) / CELL_SIZE;
+  return std::clamp(row, 0, ROWS - 1);
+}
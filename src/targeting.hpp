@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <raylib.h>
+#include <raymath.h>
+
+#include "asteroid.hpp"
+
+struct Target
+{
+  Vector2 position{};
+  uint32_t id{ 0 };
+  Asteroid::Type type{ Asteroid::Type::Size3 };
+};
+
+// NOTE: Uniform grid over the wrapping playfield, rebuilt once per tick from the asteroid pools.
+//       All queries compare squared minimum-image distances, so targets across the screen
+//       edge are found the same way as the ones next to the query position.
+class TargetIndex
+{
+public:
+  static constexpr const int CELL_SIZE{ 30 };
+  static constexpr const int COLUMNS{ (480 + CELL_SIZE - 1) / CELL_SIZE };
+  static constexpr const int ROWS{ (270 + CELL_SIZE - 1) / CELL_SIZE };
+  static constexpr const float WORLD_WIDTH{ 480.0f };
+  static constexpr const float WORLD_HEIGHT{ 270.0f };
+
+  void build(const AsteroidPools &asteroids);
+  void clear() noexcept;
+
+  [[nodiscard]] size_t size() const noexcept { return targets.size(); }
+  [[nodiscard]] bool empty() const noexcept { return targets.empty(); }
+
+  [[nodiscard]] const Target *find(uint32_t id) const noexcept;
+
+  [[nodiscard]] const Target *nearest(const Vector2 &position,
+                                      float max_distance = std::numeric_limits<float>::max()) const noexcept;
+  [[nodiscard]] const Target *nearest_of_type(const Vector2 &position,
+                                              Asteroid::Type type,
+                                              float max_distance = std::numeric_limits<float>::max()) const noexcept;
+  // direction has to be normalized, cos_half_angle is the cosine of half of the cone opening
+  [[nodiscard]] const Target *nearest_in_cone(const Vector2 &position,
+                                              const Vector2 &direction,
+                                              float cos_half_angle,
+                                              float max_distance = std::numeric_limits<float>::max()) const noexcept;
+  // fills result with up to result.size() targets sorted by distance, returns number of targets found
+  size_t nearest_k(const Vector2 &position,
+                   std::span<const Target *> result,
+                   float max_distance = std::numeric_limits<float>::max()) const noexcept;
+
+  template<typename Predicate>
+  [[nodiscard]] const Target *nearest_if(const Vector2 &position, float max_distance, Predicate predicate) const noexcept
+  {
+    const Target *best{ nullptr };
+    float best_distance_sq = max_distance < std::numeric_limits<float>::max() ? max_distance * max_distance
+                                                                              : std::numeric_limits<float>::max();
+
+    search(
+      position,
+      [&](const Target &target, const Vector2 &delta, float distance_sq)
+      {
+        if (distance_sq < best_distance_sq && predicate(target, delta, distance_sq))
+        {
+          best             = &target;
+          best_distance_sq = distance_sq;
+        }
+      },
+      [&](float ring_distance_sq) { return ring_distance_sq >= best_distance_sq; });
+
+    return best;
+  }
+
+  // shortest vector from `from` to `to` on the wrapping playfield
+  [[nodiscard]] static Vector2 wrapped_delta(const Vector2 &from, const Vector2 &to) noexcept;
+
+private:
+  std::vector<Target> targets;
+  std::vector<Target> unsorted_targets;
+  std::vector<uint16_t> target_cells;
+  std::vector<std::pair<uint32_t, uint16_t>> id_lookup;
+  std::array<uint16_t, COLUMNS * ROWS + 1> cell_start{};
+
+  // visit(target, delta, distance_sq) is called for targets ring by ring around the query cell,
+  // the search ends when stop(squared distance to the closest cell of the next ring) returns true
+  template<typename Visit, typename Stop>
+  void search(const Vector2 &position, Visit visit, Stop stop) const noexcept
+  {
+    if (targets.empty())
+      return;
+
+    const int cell_x = column_of(position.x);
+    const int cell_y = row_of(position.y);
+    std::bitset<COLUMNS * ROWS> visited;
+
+    constexpr const int MAX_RING = std::max(COLUMNS, ROWS) / 2 + 1;
+    for (int ring = 0; ring <= MAX_RING; ++ring)
+    {
+      const float ring_distance = static_cast<float>(std::max(0, ring - 1) * CELL_SIZE);
+      if (stop(ring_distance * ring_distance))
+        return;
+
+      for (int dy = -ring; dy <= ring; ++dy)
+      {
+        const int step = (dy == -ring || dy == ring) ? 1 : std::max(1, 2 * ring);
+        for (int dx = -ring; dx <= ring; dx += step)
+        {
+          const int column = (cell_x + dx % COLUMNS + COLUMNS) % COLUMNS;
+          const int row    = (cell_y + dy % ROWS + ROWS) % ROWS;
+          const int cell   = row * COLUMNS + column;
+          if (visited.test(cell))
+            continue;
+          visited.set(cell);
+
+          for (uint16_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i)
+          {
+            const Target &target = targets[i];
+            const Vector2 delta  = wrapped_delta(position, target.position);
+            visit(target, delta, delta.x * delta.x + delta.y * delta.y);
+          }
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] static int column_of(float x) noexcept;
+  [[nodiscard]] static int row_of(float y) noexcept;
+};
@@ -0,0 +1,236 @@
+#include "text_layout.hpp"
+
+#include <array>
+#include <functional>
+
+#include <rlgl.h>
+
+static constexpr const std::array<Vector2, 1> DROP_SHADOW_OFFSETS{ Vector2{ 0.0f, 1.0f } };
+static constexpr const std::array<Vector2, 9> OUTLINE_OFFSETS{
+  Vector2{ -1.0f, -1.0f }, Vector2{ 0.0f, -1.0f }, Vector2{ 1.0f, -1.0f },
+  Vector2{ -1.0f, 0.0f },  Vector2{ 0.0f, 0.0f },  Vector2{ 1.0f, 0.0f },
+  Vector2{ -1.0f, 1.0f },  Vector2{ 0.0f, 1.0f },  Vector2{ 1.0f, 1.0f },
+};
+
+void TextLayout::draw(const Vector2 &position, const Color &color, const Color &shadow_color) const noexcept
+{
+  if (quads.empty() || texture.id == 0)
+    return;
+
+  rlCheckRenderBatchLimit(static_cast<int>(quads.size()) * 4);
+
+  // NOTE: Same vertices as DrawTexturePro, but with a single texture bind for the whole string
+  rlSetTexture(texture.id);
+  rlBegin(RL_QUADS);
+  rlNormal3f(0.0f, 0.0f, 1.0f);
+
+  for (size_t i = 0; i < quads.size(); i++)
+  {
+    const Color &tint = i < shadow_quad_count ? shadow_color : color;
+    const Quad &quad  = quads[i];
+    const float x     = position.x + quad.rect.x;
+    const float y     = position.y + quad.rect.y;
+
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+
+    rlTexCoord2f(quad.uv.x, quad.uv.y);
+    rlVertex2f(x, y);
+    rlTexCoord2f(quad.uv.x, quad.uv.height);
+    rlVertex2f(x, y + quad.rect.height);
+    rlTexCoord2f(quad.uv.width, quad.uv.height);
+    rlVertex2f(x + quad.rect.width, y + quad.rect.height);
+    rlTexCoord2f(quad.uv.width, quad.uv.y);
+    rlVertex2f(x + quad.rect.width, y);
+  }
+
+  rlEnd();
+  rlSetTexture(0);
+}
+
+const TextLayout &TextLayoutCache::get(const Font &font,
+                                       std::string_view text,
+                                       float font_size,
+                                       float spacing,
+                                       TextShadow shadow,
+                                       float line_spacing)
+{
+  Key key{ .font         = font.texture.id,
+           .font_size    = font_size,
+           .spacing      = spacing,
+           .line_spacing = line_spacing,
+           .shadow       = shadow,
+           .text         = text };
+
+  auto it = layouts.find(key);
+  if (it == layouts.end())
+  {
+    auto entry    = std::make_unique<Entry>();
+    entry->text   = std::string(text);
+    key.text      = entry->text;
+    entry->layout = layout_text(font.texture.id != 0 ? font : GetFontDefault(), key);
+    it            = layouts.emplace(key, std::move(entry)).first;
+  }
+
+  TextLayout &layout = it->second->layout;
+  layout.last_used   = generation;
+  return layout;
+}
+
+TextLayout TextLayoutCache::layout(const Font &font,
+                                   const char *text,
+                                   float font_size,
+                                   float spacing,
+                                   TextShadow shadow,
+                                   float line_spacing)
+{
+  const Key key{ .font         = font.texture.id,
+                 .font_size    = font_size,
+                 .spacing      = spacing,
+                 .line_spacing = line_spacing,
+                 .shadow       = shadow,
+                 .text         = text };
+  return layout_text(font.texture.id != 0 ? font : GetFontDefault(), key);
+}
+
+Vector2 TextLayoutCache::draw(const Font &font,
+                              std::string_view text,
+                              const Vector2 &position,
+                              float font_size,
+                              float spacing,
+                              const Color &color,
+                              TextShadow shadow,
+                              const Color &shadow_color,
+                              float line_spacing)
+{
+  const TextLayout &layout = get(font, text, font_size, spacing, shadow, line_spacing);
+  layout.draw(position, color, shadow_color);
+  return layout.size;
+}
+
+void TextLayoutCache::collect()
+{
+  generation++;
+  if (generation % EVICTION_AGE != 0)
+    return;
+
+  std::erase_if(layouts,
+                [this](const auto &item) { return generation - item.second->layout.last_used > EVICTION_AGE; });
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const Key &key) const noexcept
+{
+  size_t hash = std::hash<std::string_view>{}(key.text);
+  hash        = hash * 31 + std::hash<unsigned int>{}(key.font);
+  hash        = hash * 31 + std::hash<float>{}(key.font_size);
+  hash        = hash * 31 + std::hash<float>{}(key.spacing);
+  hash        = hash * 31 + std::hash<float>{}(key.line_spacing);
+  hash        = hash * 31 + static_cast<size_t>(key.shadow);
+  return hash;
+}
+
+TextLayout TextLayoutCache::layout_text(const Font &font, const Key &key)
+{
+  TextLayout layout;
+  layout.texture = font.texture;
+
+  // NOTE: MeasureTextEx needs a null terminated string, the key views the string owned by the entry.
+  //       Its height uses the global line spacing, so it is computed from the key below.
+  const char *text = key.text.data();
+  layout.size      = MeasureTextEx(font, text, key.font_size, key.spacing);
+
+  // NOTE: Follows DrawTextEx and DrawTextCodepoint
+  std::vector<TextLayout::Quad> glyphs;
+  const float scale_factor   = key.font_size / static_cast<float>(font.baseSize);
+  const float padding        = static_cast<float>(font.glyphPadding);
+  const float texture_width  = static_cast<float>(font.texture.width);
+  const float texture_height = static_cast<float>(font.texture.height);
+  float offset_x             = 0.0f;
+  float offset_y             = 0.0f;
+
+  int line_count = 0;
+  const int size = static_cast<int>(key.text.size());
+  for (int i = 0; i < size;)
+  {
+    int codepoint_byte_count = 0;
+    const int codepoint      = GetCodepointNext(&text[i], &codepoint_byte_count);
+    const int index          = GetGlyphIndex(font, codepoint);
+    i += codepoint_byte_count;
+
+    if (codepoint == '\n')
+    {
+      line_count++;
+      offset_y += key.line_spacing;
+      offset_x = 0.0f;
+      continue;
+    }
+
+    const Rectangle &rec   = font.recs[index];
+    const GlyphInfo &glyph = font.glyphs[index];
+    if (codepoint != ' ' && codepoint != '\t')
+    {
+      const Rectangle source{
+        rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding
+      };
+      glyphs.push_back(TextLayout::Quad{
+        .uv   = Rectangle{ source.x / texture_width,
+                         source.y / texture_height,
+                         (source.x + source.width) / texture_width,
+                         (source.y + source.height) / texture_height },
+        .rect = Rectangle{ offset_x + static_cast<float>(glyph.offsetX) * scale_factor - padding * scale_factor,
+                           offset_y + static_cast<float>(glyph.offsetY) * scale_factor - padding * scale_factor,
+                           source.width * scale_factor,
+                           source.height * scale_factor } });
+    }
+
+    if (glyph.advanceX == 0)
+      offset_x += rec.width * scale_factor + key.spacing;
+    else
+      offset_x += static_cast<float>(glyph.advanceX) * scale_factor + key.spacing;
+  }
+
+  const float line_height = static_cast<float>(line_count) * key.line_spacing;
+  layout.size.y           = (static_cast<float>(font.baseSize) + line_height) * scale_factor;
+
+  auto add_shadow = [&](const auto &offsets)
+  {
+    for (const Vector2 &offset : offsets)
+    {
+      for (TextLayout::Quad quad : glyphs)
+      {
+        quad.rect.x += offset.x;
+        quad.rect.y += offset.y;
+        layout.quads.push_back(quad);
+      }
+    }
+  };
+
+  switch (key.shadow)
+  {
+    case TextShadow::None:
+      break;
+    case TextShadow::Drop:
+      add_shadow(DROP_SHADOW_OFFSETS);
+      break;
+    case TextShadow::Outline:
+      add_shadow(OUTLINE_OFFSETS);
+      break;
+  }
+
+  layout.shadow_quad_count = layout.quads.size();
+  layout.quads.insert(layout.quads.end(), glyphs.begin(), glyphs.end());
+  return layout;
+}
+
+const TextLayout &ValueText::get(const Font &font, int64_t first, int64_t second)
+{
+  const std::array<int64_t, 2> next_values{ first, second };
+  if (values == next_values && font_id == font.texture.id)
+    return layout;
+
+  // NOTE: Formats that use only the first value ignore the second argument
+  const char *text = TextFormat(format, static_cast<long long>(first), static_cast<long long>(second));
+  layout           = TextLayoutCache::layout(font, text, font_size, spacing, shadow);
+  values           = next_values;
+  font_id          = font.texture.id;
+  return layout;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+enum class TextShadow : uint8_t
+{
+  None,
+  Drop,   // one copy moved a pixel down
+  Outline // copies on the 3x3 pixels around the text
+};
+
+// NOTE: Glyph quads of a string laid out the same way as DrawTextEx, relative to the text position.
+//       Shadow quads come first and are drawn with their own colour.
+struct TextLayout
+{
+  struct Quad
+  {
+    Rectangle uv{};   // normalized x0, y0, x1, y1 in the font atlas
+    Rectangle rect{}; // relative to the text position
+  };
+
+  Texture2D texture{};
+  std::vector<Quad> quads;
+  size_t shadow_quad_count{ 0 };
+  Vector2 size{ 0.0f, 0.0f }; // same as MeasureTextEx, without the shadow
+
+  void draw(const Vector2 &position, const Color &color, const Color &shadow_color = BLACK) const noexcept;
+
+private:
+  uint64_t last_used{ 0 };
+
+  friend class TextLayoutCache;
+};
+
+// NOTE: Layouts are keyed by font, string, size, spacing and shadow. A string is laid out and measured once
+//       and replayed as quads afterwards, until it is not used for EVICTION_AGE generations.
+class TextLayoutCache
+{
+public:
+  static constexpr const float DEFAULT_LINE_SPACING{ 15.0f }; // raylib default
+  static constexpr const uint64_t EVICTION_AGE{ 120 };
+
+  [[nodiscard]] const TextLayout &get(const Font &font,
+                                      std::string_view text,
+                                      float font_size,
+                                      float spacing,
+                                      TextShadow shadow  = TextShadow::None,
+                                      float line_spacing = DEFAULT_LINE_SPACING);
+
+  // draws text like DrawTextEx and returns its size like MeasureTextEx
+  Vector2 draw(const Font &font,
+               std::string_view text,
+               const Vector2 &position,
+               float font_size,
+               float spacing,
+               const Color &color,
+               TextShadow shadow         = TextShadow::None,
+               const Color &shadow_color = BLACK,
+               float line_spacing        = DEFAULT_LINE_SPACING);
+
+  // lays out a null terminated text without caching it, for owners that know when their text changes
+  [[nodiscard]] static TextLayout layout(const Font &font,
+                                         const char *text,
+                                         float font_size,
+                                         float spacing,
+                                         TextShadow shadow  = TextShadow::None,
+                                         float line_spacing = DEFAULT_LINE_SPACING);
+
+  // starts a new generation and drops the layouts that were not used for a while, call once per frame
+  void collect();
+
+  [[nodiscard]] size_t size() const noexcept { return layouts.size(); }
+
+private:
+  struct Key
+  {
+    unsigned int font{ 0 };
+    float font_size{ 0.0f };
+    float spacing{ 0.0f };
+    float line_spacing{ 0.0f };
+    TextShadow shadow{ TextShadow::None };
+    std::string_view text;
+
+    bool operator==(const Key &) const = default;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key &key) const noexcept;
+  };
+
+  // NOTE: Owns the string the key views, so lookups with a temporary string_view do not allocate
+  struct Entry
+  {
+    std::string text;
+    TextLayout layout;
+  };
+
+  [[nodiscard]] static TextLayout layout_text(const Font &font, const Key &key);
+
+  std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash> layouts;
+  uint64_t generation{ 0 };
+};
+
+// NOTE: Text of a format with up to two integers, like "Score: %lld". It keeps the values it was formatted with
+//       and is formatted and laid out again only when one of them changes, an unchanged text is neither formatted
+//       nor hashed.
+class ValueText
+{
+public:
+  ValueText(const char *format, float font_size, float spacing, TextShadow shadow = TextShadow::None) noexcept
+    : format(format), font_size(font_size), spacing(spacing), shadow(shadow)
+  {
+  }
+
+  [[nodiscard]] const TextLayout &get(const Font &font, int64_t first, int64_t second = 0);
+
+private:
+  const char *format;
+  float font_size;
+  float spacing;
+  TextShadow shadow;
+
+  unsigned int font_id{ 0 };
+  std::optional<std::array<int64_t, 2>> values;
+  TextLayout layout;
+};
@@ -0,0 +1,61 @@
+#include "tile_chunks.hpp"
+
+#include <cassert>
+#include <cmath>
+
+TileChunks::TileChunks(std::vector<Tile> &&layer_tiles, float tile_size)
+  : chunk_size(tile_size * static_cast<float>(CHUNK_TILES))
+{
+  assert(tile_size > 0.0f);
+
+  if (layer_tiles.empty())
+    return;
+
+  auto chunk_coordinate = [this](float position)
+  { return std::max(0, static_cast<int>(std::floor(position / chunk_size))); };
+
+  for (const auto &tile : layer_tiles)
+  {
+    columns = std::max(columns, chunk_coordinate(tile.position.x) + 1);
+    rows    = std::max(rows, chunk_coordinate(tile.position.y) + 1);
+  }
+
+  auto chunk_index = [&](const Tile &tile)
+  { return static_cast<size_t>(chunk_coordinate(tile.position.y) * columns + chunk_coordinate(tile.position.x)); };
+
+  // NOTE: Counting sort by chunk, stable so the tiles of a chunk keep the layer order
+  chunks.resize(static_cast<size_t>(columns * rows));
+  for (const auto &tile : layer_tiles)
+    chunks[chunk_index(tile)].end++;
+
+  uint32_t offset = 0;
+  for (auto &chunk : chunks)
+  {
+    const uint32_t count = chunk.end;
+    chunk.begin          = offset;
+    chunk.end            = offset;
+    offset += count;
+  }
+
+  tiles.resize(layer_tiles.size());
+  for (const auto &tile : layer_tiles)
+  {
+    Chunk &chunk = chunks[chunk_index(tile)];
+    const Rectangle tile_rect{ tile.position.x, tile.position.y, tile.size.x, tile.size.y };
+    if (chunk.begin == chunk.end)
+      chunk.bounds = tile_rect;
+    else
+    {
+      const float right   = std::max(chunk.bounds.x + chunk.bounds.width, tile_rect.x + tile_rect.width);
+      const float bottom  = std::max(chunk.bounds.y + chunk.bounds.height, tile_rect.y + tile_rect.height);
+      chunk.bounds.x      = std::min(chunk.bounds.x, tile_rect.x);
+      chunk.bounds.y      = std::min(chunk.bounds.y, tile_rect.y);
+      chunk.bounds.width  = right - chunk.bounds.x;
+      chunk.bounds.height = bottom - chunk.bounds.y;
+    }
+
+    tiles[chunk.end++] = tile;
+  }
+
+  TraceLog(LOG_TRACE, "   > %zu tiles in %dx%d chunks", tiles.size(), columns, rows);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+
+struct Tile
+{
+  Vector2 position;
+  Vector2 size;
+  Rectangle source;
+};
+
+// NOTE: Static tiles of a layer bucketed into chunks of CHUNK_TILES x CHUNK_TILES grid cells. Tiles of a chunk
+//       are stored contiguously in their original order, so drawing the visible chunks only touches those tiles.
+class TileChunks
+{
+public:
+  static constexpr const int CHUNK_TILES{ 16 };
+
+  TileChunks() = default;
+  TileChunks(std::vector<Tile> &&tiles, float tile_size);
+
+  // calls function for every tile of the chunks overlapping view, chunk by chunk
+  template <typename Function>
+  void for_each_visible(const Rectangle &view, Function &&function) const
+  {
+    if (chunks.empty())
+      return;
+
+    // NOTE: Tiles larger than a grid cell reach into the next chunks, so the range starts one chunk earlier
+    const int first_column = std::max(0, static_cast<int>(view.x / chunk_size) - 1);
+    const int first_row    = std::max(0, static_cast<int>(view.y / chunk_size) - 1);
+    const int last_column  = std::min(columns - 1, static_cast<int>((view.x + view.width) / chunk_size));
+    const int last_row     = std::min(rows - 1, static_cast<int>((view.y + view.height) / chunk_size));
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+      for (int column = first_column; column <= last_column; column++)
+      {
+        const Chunk &chunk = chunks[static_cast<size_t>(row * columns + column)];
+        if (chunk.begin == chunk.end || !CheckCollisionRecs(chunk.bounds, view))
+          continue;
+
+        for (uint32_t i = chunk.begin; i < chunk.end; i++)
+          function(tiles[i]);
+      }
+    }
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return tiles.empty(); }
+  [[nodiscard]] size_t size() const noexcept { return tiles.size(); }
+  [[nodiscard]] size_t chunk_count() const noexcept { return chunks.size(); }
+
+private:
+  struct Chunk
+  {
+    Rectangle bounds{}; // union of the tiles, can be larger than the chunk cell
+    uint32_t begin{ 0 };
+    uint32_t end{ 0 };
+  };
+
+  std::vector<Tile> tiles;
+  std::vector<Chunk> chunks;
+  float chunk_size{ 1.0f };
+  int columns{ 0 };
+  int rows{ 0 };
+};
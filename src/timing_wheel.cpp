@@ -0,0 +1,222 @@
+#include "timing_wheel.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+TimingWheel::TimingWheel()
+{
+  slot_heads.fill(NONE);
+}
+
+TimingWheel::Handle TimingWheel::schedule(uint64_t delay_ticks, Callback &&callback)
+{
+  const uint32_t index = allocate(delay_ticks, 0, std::move(callback));
+  return Handle{ index, events[index].generation };
+}
+
+TimingWheel::Handle TimingWheel::schedule_repeating(uint32_t period_ticks, Callback &&callback)
+{
+  assert(period_ticks > 0);
+  const uint32_t index = allocate(period_ticks, period_ticks, std::move(callback));
+  return Handle{ index, events[index].generation };
+}
+
+bool TimingWheel::cancel(Handle &handle) noexcept
+{
+  if (!is_pending(handle))
+    return false;
+
+  Event &event = events[handle.index];
+  if (event.slot == NONE)
+  {
+    // NOTE: Event is being fired right now, it is released once its callback returns
+    event.active = false;
+  }
+  else
+  {
+    unlink(handle.index);
+    release(handle.index);
+  }
+
+  handle = Handle{};
+  return true;
+}
+
+bool TimingWheel::is_pending(const Handle &handle) const noexcept
+{
+  return handle.index < events.size() && events[handle.index].generation == handle.generation &&
+         events[handle.index].active;
+}
+
+void TimingWheel::advance()
+{
+  current_tick++;
+
+  // NOTE: Every time a finer level wraps around, the matching slot of the next level is spread over it
+  if ((current_tick & (LEVEL0_SLOTS - 1)) == 0)
+  {
+    for (uint32_t level = 1; level < LEVELS; level++)
+    {
+      const uint32_t shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+      const uint32_t index = static_cast<uint32_t>((current_tick >> shift) & (LEVEL_SLOTS - 1));
+      cascade(LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS + index);
+
+      if (index != 0)
+        break;
+    }
+  }
+
+  const uint32_t slot = static_cast<uint32_t>(current_tick & (LEVEL0_SLOTS - 1));
+  if (slot_heads[slot] == NONE)
+    return;
+
+  // NOTE: Expired events are moved to a separate list, so callbacks can safely schedule and cancel events
+  while (slot_heads[slot] != NONE)
+  {
+    const uint32_t index = slot_heads[slot];
+    unlink(index);
+    link(index, FIRING_SLOT);
+  }
+
+  while (slot_heads[FIRING_SLOT] != NONE)
+  {
+    const uint32_t index = slot_heads[FIRING_SLOT];
+    unlink(index);
+
+    // NOTE: The callback may schedule new events and reallocate the pool
+    Callback callback = std::move(events[index].callback);
+    callback();
+
+    Event &event = events[index];
+    if (event.active && event.period > 0)
+    {
+      event.callback = std::move(callback);
+      event.expires  = current_tick + event.period;
+      insert(index);
+    }
+    else
+    {
+      release(index);
+    }
+  }
+}
+
+void TimingWheel::clear() noexcept
+{
+  for (uint32_t slot = 0; slot < slot_heads.size(); slot++)
+  {
+    while (slot_heads[slot] != NONE)
+    {
+      const uint32_t index = slot_heads[slot];
+      unlink(index);
+      release(index);
+    }
+  }
+}
+
+uint32_t TimingWheel::allocate(uint64_t delay_ticks, uint32_t period, Callback &&callback)
+{
+  uint32_t index;
+  if (!free_events.empty())
+  {
+    index = free_events.back();
+    free_events.pop_back();
+  }
+  else
+  {
+    assert(events.size() < NONE);
+    index = static_cast<uint32_t>(events.size());
+    events.emplace_back();
+  }
+
+  Event &event   = events[index];
+  event.callback = std::move(callback);
+  event.expires  = current_tick + std::clamp<uint64_t>(delay_ticks, 1, MAX_DELAY);
+  event.period   = period;
+  event.active   = true;
+  pending_events++;
+
+  insert(index);
+  return index;
+}
+
+void TimingWheel::release(uint32_t index) noexcept
+{
+  Event &event = events[index];
+  assert(event.slot == NONE);
+
+  event.callback = nullptr;
+  event.active   = false;
+  event.generation++;
+  free_events.push_back(index);
+  pending_events--;
+}
+
+void TimingWheel::insert(uint32_t index) noexcept
+{
+  const uint64_t expires = events[index].expires;
+  const uint64_t delta   = expires > current_tick ? expires - current_tick : 0;
+
+  // NOTE: Cascaded events may expire on the current tick, which is fired right after the cascade
+  if (delta < LEVEL0_SLOTS)
+  {
+    link(index, static_cast<uint32_t>(expires & (LEVEL0_SLOTS - 1)));
+    return;
+  }
+
+  for (uint32_t level = 1; level < LEVELS; level++)
+  {
+    const uint32_t shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+    if (delta < (uint64_t{ 1 } << (shift + LEVEL_BITS)) || level == LEVELS - 1)
+    {
+      const uint32_t slot = static_cast<uint32_t>((expires >> shift) & (LEVEL_SLOTS - 1));
+      link(index, LEVEL0_SLOTS + (level - 1) * LEVEL_SLOTS + slot);
+      return;
+    }
+  }
+}
+
+void TimingWheel::link(uint32_t index, uint32_t slot) noexcept
+{
+  Event &event   = events[index];
+  event.slot     = slot;
+  event.previous = NONE;
+  event.next     = slot_heads[slot];
+  if (event.next != NONE)
+    events[event.next].previous = index;
+  slot_heads[slot] = index;
+}
+
+void TimingWheel::unlink(uint32_t index) noexcept
+{
+  Event &event = events[index];
+  assert(event.slot != NONE);
+
+  if (event.previous != NONE)
+    events[event.previous].next = event.next;
+  else
+    slot_heads[event.slot] = event.next;
+
+  if (event.next != NONE)
+    events[event.next].previous = event.previous;
+
+  event.previous = NONE;
+  event.next     = NONE;
+  event.slot     = NONE;
+}
+
+void TimingWheel::cascade(uint32_t slot) noexcept
+{
+  uint32_t index   = slot_heads[slot];
+  slot_heads[slot] = NONE;
+
+  while (index != NONE)
+  {
+    const uint32_t next    = events[index].next;
+    events[index].slot     = NONE;
+    events[index].previous = NONE;
+    events[index].next     = NONE;
+    insert(index);
+    index = next;
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// NOTE: Hierarchical timing wheel counting game ticks. Scheduling and cancelling an event is O(1),
+//       advancing a tick only touches the events that expire on it (plus an occasional cascade
+//       of a coarser slot into the finer levels). Events are stored in a pool and referred to by
+//       generation checked handles, so a handle of an already fired event is simply not pending.
+class TimingWheel
+{
+public:
+  using Callback = std::function<void()>;
+
+  struct Handle
+  {
+    uint32_t index{ std::numeric_limits<uint32_t>::max() };
+    uint32_t generation{ 0 };
+  };
+
+  TimingWheel();
+
+  // callback is called after `delay_ticks` calls to advance(), a delay of 0 is treated as 1
+  Handle schedule(uint64_t delay_ticks, Callback &&callback);
+  // callback is called every `period_ticks` until the event is cancelled
+  Handle schedule_repeating(uint32_t period_ticks, Callback &&callback);
+  bool cancel(Handle &handle) noexcept;
+  [[nodiscard]] bool is_pending(const Handle &handle) const noexcept;
+
+  void advance();
+  void clear() noexcept;
+
+  [[nodiscard]] uint64_t now() const noexcept { return current_tick; }
+  [[nodiscard]] size_t size() const noexcept { return pending_events; }
+
+private:
+  static constexpr const uint32_t LEVEL0_BITS{ 8 };
+  static constexpr const uint32_t LEVEL_BITS{ 6 };
+  static constexpr const uint32_t LEVELS{ 4 };
+  static constexpr const uint32_t LEVEL0_SLOTS{ 1 << LEVEL0_BITS };
+  static constexpr const uint32_t LEVEL_SLOTS{ 1 << LEVEL_BITS };
+  static constexpr const uint32_t SLOTS{ LEVEL0_SLOTS + (LEVELS - 1) * LEVEL_SLOTS };
+  static constexpr const uint32_t FIRING_SLOT{ SLOTS };
+  static constexpr const uint64_t MAX_DELAY{ (uint64_t{ 1 } << (LEVEL0_BITS + (LEVELS - 1) * LEVEL_BITS)) - 1 };
+  static constexpr const uint32_t NONE{ std::numeric_limits<uint32_t>::max() };
+
+  struct Event
+  {
+    Callback callback{};
+    uint64_t expires{ 0 };
+    uint32_t period{ 0 };
+    uint32_t generation{ 0 };
+    uint32_t previous{ NONE };
+    uint32_t next{ NONE };
+    uint32_t slot{ NONE };
+    bool active{ false };
+  };
+
+  std::vector<Event> events;
+  std::vector<uint32_t> free_events;
+  std::array<uint32_t, SLOTS + 1> slot_heads;
+  uint64_t current_tick{ 0 };
+  size_t pending_events{ 0 };
+
+  uint32_t allocate(uint64_t delay_ticks, uint32_t period, Callback &&callback);
+  void release(uint32_t index) noexcept;
+
+  void insert(uint32_t index) noexcept;
+  void link(uint32_t index, uint32_t slot) noexcept;
+  void unlink(uint32_t index) noexcept;
+  void cascade(uint32_t slot) noexcept;
+};
@@ -0,0 +1,52 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <raylib.h>
+
+// NOTE: Converts audio files raylib can load (wav, mp3, ogg) to QOA, usage:
+//       qoa_convert <output directory> <input files...>
+//       Every input is written to the output directory with the same name and the .qoa extension.
+int main(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    std::fprintf(stderr, "usage: %s <output directory> <input files...>\n", argv[0]);
+    return 1;
+  }
+
+  const std::filesystem::path output_directory{ argv[1] };
+  std::filesystem::create_directories(output_directory);
+
+  int failed = 0;
+  for (int i = 2; i < argc; ++i)
+  {
+    const std::filesystem::path input{ argv[i] };
+    const std::string output = (output_directory / input.filename()).replace_extension(".qoa").string();
+
+    Wave wave = LoadWave(input.string().c_str());
+    if (!IsWaveReady(wave))
+    {
+      failed++;
+      continue;
+    }
+
+    // NOTE: The QOA encoder only takes 16 bit samples
+    if (wave.sampleSize != 16)
+      WaveFormat(&wave, static_cast<int>(wave.sampleRate), 16, static_cast<int>(wave.channels));
+
+    if (!ExportWave(wave, output.c_str()))
+      failed++;
+    else
+      TraceLog(LOG_INFO,
+               "QOA: %s -> %s (%u frames, %u channels)",
+               input.string().c_str(),
+               output.c_str(),
+               wave.frameCount,
+               wave.channels);
+
+    UnloadWave(wave);
+  }
+
+  return failed == 0 ? 0 : 1;
+}
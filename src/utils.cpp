@@ -36,26 +36,30 @@ void wrap_position(Vector2 &position)
     position.y = 0;
 }
 
-void draw_wrapped(const Rectangle &rect, const std::function<void(const Vector2 &)> draw_function)
+WrapOffsets wrap_offsets(const Rectangle &rect, const Rectangle &view) noexcept
 {
-  const auto &x = rect.x;
-  const auto &y = rect.y;
-  const auto &w = rect.width;
-  const auto &h = rect.height;
-
-  if (x <= w)
-    draw_function(Vector2{ x + Game::width, y });
-
-  if (x + w >= Game::width)
-    draw_function(Vector2{ x - Game::width, y });
-
-  if (y <= h)
-    draw_function(Vector2{ x, y + Game::height });
+  const float half_w  = rect.width * 0.5f;
+  const float half_h  = rect.height * 0.5f;
+  const float world_w = static_cast<float>(Game::width);
+  const float world_h = static_cast<float>(Game::height);
+
+  // NOTE: An image overlaps the view when its center is at most its half extent outside of the view on both axes
+  WrapOffsets offsets;
+  for (const float offset : { 0.0f, world_w, -world_w })
+  {
+    const float x = rect.x + offset;
+    if (x + half_w >= view.x && x - half_w <= view.x + view.width)
+      offsets.x[offsets.x_count++] = offset;
+  }
 
-  if (y + h >= Game::height)
-    draw_function(Vector2{ x, y - Game::height });
+  for (const float offset : { 0.0f, world_h, -world_h })
+  {
+    const float y = rect.y + offset;
+    if (y + half_h >= view.y && y - half_h <= view.y + view.height)
+      offsets.y[offsets.y_count++] = offset;
+  }
 
-  draw_function(Vector2{ x, y });
+  return offsets;
 }
 
 std::string idle_tag_from_direction(const Direction &direction)
@@ -1,7 +1,9 @@
 #pragma once
 
 #define _USE_MATH_DEFINES
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -35,7 +37,28 @@ inline constexpr const char *RESOURCE_PATH{ "resources/" };
 
 void wrap_position(Vector2 &position);
 
-void draw_wrapped(const Rectangle &rect, const std::function<void(const Vector2 &)> draw_function);
+// NOTE: Offsets of the torus images of a rectangle centered on its x, y that intersect the view, per axis.
+//       An image is drawn for every x and y pair, so corner images are included when both axes wrap.
+struct WrapOffsets
+{
+  std::array<float, 3> x{};
+  std::array<float, 3> y{};
+  uint8_t x_count{ 0 };
+  uint8_t y_count{ 0 };
+};
+
+[[nodiscard]] WrapOffsets wrap_offsets(const Rectangle &rect, const Rectangle &view) noexcept;
+
+// calls draw_function with the center of every image of rect inside the view, an entity away from the edges is
+// drawn once and one outside of the view is not drawn at all
+template <typename DrawFunction>
+void draw_wrapped(const Rectangle &rect, const Rectangle &view, DrawFunction &&draw_function)
+{
+  const WrapOffsets offsets = wrap_offsets(rect, view);
+  for (uint8_t j = 0; j < offsets.y_count; j++)
+    for (uint8_t i = 0; i < offsets.x_count; i++)
+      draw_function(Vector2{ rect.x + offsets.x[i], rect.y + offsets.y[j] });
+}
 
 enum class Direction
 {